@@ -0,0 +1,228 @@
+/*##############################################################################
+
+    Copyright (C) 2025 HPCC Systems®.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+############################################################################## */
+
+#include "eventindexreplay.h"
+#include "jevent.hpp"
+#include "jstring.hpp"
+#include "jthread.hpp"
+#include <algorithm>
+
+class CAccessCollector : public CInterfaceOf<IEventVisitor>
+{
+public:
+    CAccessCollector(CMetaInfoState& _metaState, std::vector<CIndexReplayOp::Access>& _accesses, std::unordered_map<unsigned, std::string>& _paths)
+        : metaState(_metaState), accesses(_accesses), paths(_paths)
+    {
+    }
+
+    virtual bool visitFile(const char* filename, uint32_t version) override
+    {
+        return true;
+    }
+    virtual bool visitEvent(CEvent& event) override
+    {
+        switch (event.queryType())
+        {
+        case EventIndexCacheHit:
+        case EventIndexCacheMiss:
+            break;
+        default:
+            return true;
+        }
+        byte nodeKind = (byte)event.queryNumericValue(EvAttrNodeKind);
+        if (nodeKind >= CIndexReplayOp::numKinds)
+            return true;
+        unsigned fileId = (unsigned)event.queryNumericValue(EvAttrFileId);
+        if (paths.find(fileId) == paths.end())
+        {
+            const char* path = metaState.queryFilePath(fileId);
+            paths[fileId] = path ? path : "";
+        }
+        accesses.push_back({event.queryNumericValue(EvAttrEventTimestamp), event.queryNumericValue(EvAttrFileOffset), fileId, nodeKind});
+        return true;
+    }
+    virtual void departFile(uint32_t bytesRead) override
+    {
+    }
+protected:
+    CMetaInfoState& metaState;
+    std::vector<CIndexReplayOp::Access>& accesses;
+    std::unordered_map<unsigned, std::string>& paths;
+};
+
+bool CIndexReplayOp::doOp()
+{
+    Owned<IEventVisitor> collector = getAccessCollector();
+    if (!traverseEvents(*collector))
+        return false;
+    if (accesses.empty())
+        throw makeStringException(0, "no index cache hit or miss events found");
+    replayAccesses();
+    return true;
+}
+
+bool CIndexReplayOp::setCacheSize(const char* key, const char* value)
+{
+    if (streq(key, "node-cache"))
+        nodeCacheSize = friendlyStringToSize(value);
+    else if (streq(key, "leaf-cache"))
+        leafCacheSize = friendlyStringToSize(value);
+    else if (streq(key, "blob-cache"))
+        blobCacheSize = friendlyStringToSize(value);
+    else
+        return false;
+    return true;
+}
+
+IEventVisitor* CIndexReplayOp::getAccessCollector()
+{
+    return new CAccessCollector(*metaState, accesses, paths);
+}
+
+void CIndexReplayOp::replayAccesses()
+{
+    openIndexes();
+    if (nodeCacheSize)
+        setNodeCacheMem(nodeCacheSize);
+    if (leafCacheSize)
+        setLeafCacheMem(leafCacheSize);
+    if (blobCacheSize)
+        setBlobCacheMem(blobCacheSize);
+    clearNodeCache();
+
+    __uint64 startHits[numKinds], startAdds[numKinds], startEvictions[numKinds];
+    for (unsigned kind = 0; kind < numKinds; kind++)
+    {
+        startHits[kind] = queryNodeCacheStatistic((NodeType)kind, StNumCacheHits);
+        startAdds[kind] = queryNodeCacheStatistic((NodeType)kind, StNumCacheAdds);
+        startEvictions[kind] = queryNodeCacheStatistic((NodeType)kind, StNumCacheEvictions);
+    }
+
+    std::vector<std::vector<KindResults>> results(numThreads, std::vector<KindResults>(numKinds));
+    __uint64 firstTimestamp = accesses.empty() ? 0 : accesses.front().timestamp;
+    __uint64 startNs = nsTick();
+    asyncFor(numThreads, numThreads, true, [&](unsigned thread)
+    {
+        replay(thread, firstTimestamp, startNs, results[thread]);
+    });
+    __uint64 elapsedNs = nsTick() - startNs;
+
+    StringBuffer line;
+    line.append("NodeKind,Accesses,Failures,Hits,Loads,Evictions,Hit Rate,Latency P50,Latency P90,Latency P99,Latency Max,Elapsed ms,Accesses/s\n");
+    for (unsigned kind = 0; kind < numKinds; kind++)
+    {
+        std::vector<__uint64> latencies;
+        __uint64 failures = 0;
+        for (auto& threadResults : results)
+        {
+            latencies.insert(latencies.end(), threadResults[kind].latencies.begin(), threadResults[kind].latencies.end());
+            failures += threadResults[kind].failures;
+        }
+        __uint64 hits = queryNodeCacheStatistic((NodeType)kind, StNumCacheHits) - startHits[kind];
+        __uint64 adds = queryNodeCacheStatistic((NodeType)kind, StNumCacheAdds) - startAdds[kind];
+        __uint64 evictions = queryNodeCacheStatistic((NodeType)kind, StNumCacheEvictions) - startEvictions[kind];
+        __uint64 numAccesses = latencies.size() + failures;
+        line.append(queryIndexNodeTypeText((NodeType)kind)).append(',').append(numAccesses).append(',').append(failures);
+        line.append(',').append(hits).append(',').append(adds).append(',').append(evictions);
+        line.append(',').appendf("%.4f", numAccesses ? (double)hits / numAccesses : 0.0);
+        line.append(',').append(percentile(latencies, 50)).append(',').append(percentile(latencies, 90));
+        line.append(',').append(percentile(latencies, 99)).append(',').append(percentile(latencies, 100));
+        line.append(',').append(elapsedNs / 1000000).append(',').appendf("%.0f", elapsedNs ? numAccesses * 1e9 / elapsedNs : 0.0);
+        line.append('\n');
+    }
+    if (skipped)
+        line.appendf("Skipped %" I64F "u accesses to index files that could not be opened\n", skipped.load());
+    line.append(openErrors);
+    out->put(line.length(), line.str());
+}
+
+const char* CIndexReplayOp::getLocalPath(const char* recordedPath, StringBuffer& localPath) const
+{
+    if (sourcePrefix.length() && startsWith(recordedPath, sourcePrefix))
+        localPath.append(targetPrefix).append(recordedPath + sourcePrefix.length());
+    else
+        localPath.append(recordedPath);
+    return localPath;
+}
+
+void CIndexReplayOp::openIndexes()
+{
+    StringBuffer localPath;
+    for (auto& [fileId, path] : paths)
+    {
+        if (path.empty())
+            continue;
+        getLocalPath(path.c_str(), localPath.clear());
+        try
+        {
+            Owned<IKeyIndex> index = createKeyIndex(localPath, 0, false, 0);
+            index->ensureReady();
+            indexes[fileId].setown(index.getClear());
+        }
+        catch (IException* e)
+        {
+            openErrors.appendf("Cannot open index %s: ", localPath.str());
+            e->errorMessage(openErrors).append('\n');
+            e->Release();
+        }
+    }
+}
+
+void CIndexReplayOp::replay(unsigned thread, __uint64 firstTimestamp, __uint64 startNs, std::vector<KindResults>& results)
+{
+    // Prewarmers hold per-reader state, so each thread creates its own
+    std::unordered_map<unsigned, Owned<IKeyIndexPrewarmer>> prewarmers;
+    for (size_t i = thread; i < accesses.size(); i += numThreads)
+    {
+        const Access& access = accesses[i];
+        auto match = prewarmers.find(access.fileId);
+        if (match == prewarmers.end())
+        {
+            auto index = indexes.find(access.fileId);
+            IKeyIndexPrewarmer* prewarmer = (index != indexes.end()) ? index->second->createPrewarmer() : nullptr;
+            match = prewarmers.emplace(access.fileId, prewarmer).first;
+        }
+        if (!match->second)
+        {
+            skipped++;
+            continue;
+        }
+
+        if (speed > 0)
+        {
+            __uint64 dueNs = startNs + (__uint64)((access.timestamp - firstTimestamp) / speed);
+            __uint64 now = nsTick();
+            if (dueNs > now + 1000000)
+                MilliSleep((unsigned)((dueNs - now) / 1000000));
+        }
+
+        __uint64 beforeNs = nsTick();
+        if (match->second->prewarmPage(access.offset, (NodeType)access.nodeKind))
+            results[access.nodeKind].latencies.push_back(nsTick() - beforeNs);
+        else
+            results[access.nodeKind].failures++;
+    }
+}
+
+__uint64 CIndexReplayOp::percentile(std::vector<__uint64>& values, unsigned pct)
+{
+    if (values.empty())
+        return 0;
+    size_t pos = std::min(values.size() - 1, (values.size() * pct) / 100);
+    std::nth_element(values.begin(), values.begin() + pos, values.end());
+    return values[pos];
+}
@@ -0,0 +1,91 @@
+/*##############################################################################
+
+    Copyright (C) 2025 HPCC Systems®.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+############################################################################## */
+
+#pragma once
+
+#include "eventconsumption.h"
+#include "eventoperation.h"
+#include "eventvisitor.h"
+#include "jhtree.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Replay the index node accesses recorded in an event file through the production node cache.
+//
+// Every recorded access is either an IndexCacheHit or an IndexCacheMiss event, so those are the
+// only events replayed. Load and eviction events are consequences of the recorded cache
+// configuration and are instead regenerated by the real cache. Each access is applied by
+// prewarming the recorded node of a local copy of the index file, which performs the same cache
+// lookup, load and eviction as a production lookup.
+class event_decl CIndexReplayOp : public CEventConsumingOp
+{
+public:
+    static constexpr unsigned numKinds = 3; // branch, leaf and blob - the node kinds that are cached
+
+    struct Access
+    {
+        __uint64 timestamp;
+        offset_t offset;
+        unsigned fileId;
+        byte nodeKind;
+    };
+
+public:
+    virtual bool doOp() override;
+public:
+    bool setCacheSize(const char* key, const char* value);
+    void setSourcePrefix(const char* prefix) { sourcePrefix.set(prefix); }
+    void setTargetPrefix(const char* prefix) { targetPrefix.set(prefix); }
+    void setSpeed(double value) { speed = value; }
+    void setThreads(unsigned value) { numThreads = value ? value : 1; }
+
+    // Visitor recording the cache hit and miss events it is given as accesses to be replayed.
+    IEventVisitor* getAccessCollector();
+    // Replay the recorded accesses, writing the observed cache behavior, and any index files that
+    // could not be opened, to the output stream.
+    void replayAccesses();
+    const std::vector<Access>& queryAccesses() const { return accesses; }
+    // Map a recorded index file path to the path of its local copy.
+    const char* getLocalPath(const char* recordedPath, StringBuffer& localPath) const;
+
+    static __uint64 percentile(std::vector<__uint64>& values, unsigned pct);
+
+protected:
+    struct KindResults
+    {
+        std::vector<__uint64> latencies;
+        __uint64 failures{0};
+    };
+
+    void openIndexes();
+    void replay(unsigned thread, __uint64 firstTimestamp, __uint64 startNs, std::vector<KindResults>& results);
+
+protected:
+    std::vector<Access> accesses;
+    std::unordered_map<unsigned, std::string> paths;
+    std::unordered_map<unsigned, Owned<IKeyIndex>> indexes;
+    RelaxedAtomic<__uint64> skipped{0};
+    StringBuffer openErrors;
+    StringAttr sourcePrefix;
+    StringAttr targetPrefix;
+    memsize_t nodeCacheSize = 0;
+    memsize_t leafCacheSize = 0;
+    memsize_t blobCacheSize = 0;
+    double speed = 0.0;
+    unsigned numThreads = 1;
+};
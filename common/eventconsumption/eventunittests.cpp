@@ -19,6 +19,8 @@
 
 #include "eventunittests.hpp"
 #include "eventfilter.h"
+#include "eventindexreplay.h"
+#include "ctfile.hpp"
 #include "eventmodeling.h"
 #include "eventoperation.h"
 
@@ -235,4 +237,100 @@ void testEventVisitationLinks(const IPropertyTree& inputTree, const IPropertyTre
     END_TEST
 }
 
+class IndexReplayTests : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(IndexReplayTests);
+        CPPUNIT_TEST(testAccessCollection);
+        CPPUNIT_TEST(testLocalPath);
+        CPPUNIT_TEST(testPercentile);
+        CPPUNIT_TEST(testUnopenedIndex);
+    CPPUNIT_TEST_SUITE_END();
+
+    void testAccessCollection()
+    {
+        START_TEST
+        CIndexReplayOp op;
+        collectAccesses(op, "/var/lib/HPCCSystems/hpcc-data/index");
+        const std::vector<CIndexReplayOp::Access>& accesses = op.queryAccesses();
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("load events must not be replayed", size_t(2), accesses.size());
+        CPPUNIT_ASSERT_EQUAL(__uint64(100), accesses[0].timestamp);
+        CPPUNIT_ASSERT_EQUAL(offset_t(8192), accesses[0].offset);
+        CPPUNIT_ASSERT_EQUAL(1U, accesses[0].fileId);
+        CPPUNIT_ASSERT_EQUAL(byte(NodeLeaf), accesses[0].nodeKind);
+        CPPUNIT_ASSERT_EQUAL(__uint64(300), accesses[1].timestamp);
+        CPPUNIT_ASSERT_EQUAL(offset_t(0), accesses[1].offset);
+        CPPUNIT_ASSERT_EQUAL(byte(NodeBranch), accesses[1].nodeKind);
+        END_TEST
+    }
+
+    void testLocalPath()
+    {
+        CIndexReplayOp op;
+        StringBuffer localPath;
+        CPPUNIT_ASSERT_EQUAL(std::string("/data/index"), std::string(op.getLocalPath("/data/index", localPath)));
+        op.setSourcePrefix("/var/lib/HPCCSystems/hpcc-data/");
+        op.setTargetPrefix("/tmp/copy/");
+        CPPUNIT_ASSERT_EQUAL(std::string("/tmp/copy/index"), std::string(op.getLocalPath("/var/lib/HPCCSystems/hpcc-data/index", localPath.clear())));
+        CPPUNIT_ASSERT_EQUAL(std::string("/data/index"), std::string(op.getLocalPath("/data/index", localPath.clear())));
+    }
+
+    void testPercentile()
+    {
+        std::vector<__uint64> values;
+        CPPUNIT_ASSERT_EQUAL(__uint64(0), CIndexReplayOp::percentile(values, 50));
+        for (unsigned i = 100; i > 0; i--)
+            values.push_back(i);
+        CPPUNIT_ASSERT_EQUAL(__uint64(51), CIndexReplayOp::percentile(values, 50));
+        CPPUNIT_ASSERT_EQUAL(__uint64(91), CIndexReplayOp::percentile(values, 90));
+        CPPUNIT_ASSERT_EQUAL(__uint64(100), CIndexReplayOp::percentile(values, 100));
+    }
+
+    void testUnopenedIndex()
+    {
+        // Accesses to an index file that cannot be opened are counted as skipped rather than failing the replay
+        START_TEST
+        CIndexReplayOp op;
+        StringBuffer result;
+        Owned<IBufferedSerialOutputStream> stream = createBufferedSerialOutputStream(result);
+        op.setOutput(*stream);
+        collectAccesses(op, "/nonexistent/index");
+        op.replayAccesses();
+        stream->flush();
+        CPPUNIT_ASSERT_MESSAGE(result.str(), strstr(result, "Skipped 2 accesses") != nullptr);
+        CPPUNIT_ASSERT_MESSAGE(result.str(), strstr(result, "Cannot open index /nonexistent/index") != nullptr);
+        CPPUNIT_ASSERT_MESSAGE(result.str(), startsWith(result, "NodeKind,Accesses,"));
+        END_TEST
+    }
+
+private:
+    void collectAccesses(CIndexReplayOp& op, const char* path)
+    {
+        Owned<IEventVisitationLink> metaCollector = op.queryMetaInfoState().getCollector();
+        Owned<IEventVisitor> collector = op.getAccessCollector();
+        metaCollector->setNextLink(*collector);
+
+        CEvent event;
+        event.reset(MetaFileInformation);
+        event.setValue(EvAttrFileId, 1U);
+        event.setValue(EvAttrPath, path);
+        metaCollector->visitEvent(event);
+        addIndexEvent(*metaCollector, EventIndexCacheHit, 100, 8192, NodeLeaf);
+        addIndexEvent(*metaCollector, EventIndexLoad, 200, 8192, NodeLeaf);
+        addIndexEvent(*metaCollector, EventIndexCacheMiss, 300, 0, NodeBranch);
+    }
+    void addIndexEvent(IEventVisitor& visitor, EventType type, __uint64 timestamp, offset_t offset, NodeType nodeKind)
+    {
+        CEvent event;
+        event.reset(type);
+        event.setValue(EvAttrEventTimestamp, timestamp);
+        event.setValue(EvAttrFileId, 1U);
+        event.setValue(EvAttrFileOffset, __uint64(offset));
+        event.setValue(EvAttrNodeKind, unsigned(nodeKind));
+        visitor.visitEvent(event);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(IndexReplayTests);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(IndexReplayTests, "indexreplay");
+
 #endif
@@ -857,6 +857,16 @@ protected:
         StatisticCreatorType creatorType = queryCreatorType(curSubGraph.queryProp("@c"), SCTnone);
         const char * creator = curSubGraph.queryProp("@creator");
 
+        //The range of activities within the subgraph is recorded when the stats are saved, so a filter on a
+        //set of activity ids can skip subgraphs without decompressing and deserializing their statistics.
+        if (curSubGraph.hasProp("@maxActivity"))
+        {
+            unsigned minActivity = curSubGraph.getPropInt("@minActivity");
+            unsigned maxActivity = curSubGraph.getPropInt("@maxActivity");
+            if (!filter.mayMatchActivityRange(minActivity, maxActivity))
+                return false;
+        }
+
         //MORE: Check minVersion and allow early filtering
 
         //MORE: Potentially filter by creator type??
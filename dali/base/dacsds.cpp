@@ -1281,6 +1281,8 @@ CClientSDSManager::CClientSDSManager()
     childrenCanBeMissing = queryDaliServerVersion().compare(serverVersionNeeded) >= 0;
     CDaliVersion serverVersionNeeded2("3.4"); // to ensure backward compatibility
     lazyExtFlag = queryDaliServerVersion().compare(serverVersionNeeded2) >= 0 ? DAMP_SDSCMD_LAZYEXT : 0;
+    CDaliVersion snapshotVersionNeeded(SDS_SVER_MIN_SNAPSHOT);
+    snapshotAvailable = queryDaliServerVersion().compare(snapshotVersionNeeded) >= 0;
     properties = NULL;
     IPropertyTree &props = queryProperties();
     CDaliVersion serverVersionNeeded3(SDS_SVER_MIN_GETXPATHS_CONNECT);
@@ -1827,11 +1829,134 @@ IRemoteConnections *CClientSDSManager::connect(IMultipleConnector *mConnect, Ses
     return LINK(remoteConnections);
 }
 
-IRemoteConnection *CClientSDSManager::connect(const char *xpath, SessionId id, unsigned mode, unsigned timeout)
+/////////////////////
+
+// A detached copy of a server sub-tree, deserialized from the same format used to populate a connection's tree
+class CSnapshotRemoteTree : public CRemoteTreeBase
+{
+public:
+    CSnapshotRemoteTree(const char *name=NULL, IPTArrayValue *value=NULL, ChildMap *children=NULL) : CRemoteTreeBase(name, value, children) { }
+
+    virtual void deserializeSelfRT(MemoryBuffer &mb) override
+    {
+        CRemoteTreeBase::deserializeSelfRT(mb);
+        byte serverTreeInfo;
+        mb.read(serverTreeInfo);
+    }
+    virtual IPropertyTree *create(const char *name=NULL, IPTArrayValue *value=NULL, ChildMap *children=NULL, bool existing=false) override
+    {
+        return new CSnapshotRemoteTree(name, value, children);
+    }
+    virtual IPropertyTree *create(MemoryBuffer &mb) override
+    {
+        CSnapshotRemoteTree *tree = new CSnapshotRemoteTree();
+        tree->deserializeSelfRT(mb);
+        return tree;
+    }
+    virtual IPropertyTree *create(IBufferedSerialInputStream &in, PTreeDeserializeContext &ctx) override
+    {
+        Owned<CSnapshotRemoteTree> tree = new CSnapshotRemoteTree();
+        tree->deserializeFromStream(in, ctx);
+        return tree.getClear();
+    }
+};
+
+// A read-only connection to a copy of the committed state of a branch, see RTM_SNAPSHOT.
+// Nothing is held on the server, so it cannot be committed, change mode or be subscribed to.
+class CSnapshotConnection : public CInterfaceOf<IRemoteConnection>
 {
+public:
+    CSnapshotConnection(const char *_xpath, SessionId _sessionId, unsigned _mode, IPropertyTree *_root)
+        : xpath(_xpath), sessionId(_sessionId), mode(_mode), root(_root)
+    {
+    }
+
+    virtual IPropertyTree *queryRoot() override { return root; }
+    virtual IPropertyTree *getRoot() override { return root.getLink(); }
+    virtual void changeMode(unsigned mode, unsigned timeout, bool suppressReloads) override { throwReadOnly("changeMode"); }
+    virtual void rollback() override { }
+    virtual void rollbackChildren(const char *xpath, bool force) override { }
+    virtual void rollbackChildren(IPropertyTree *parent, bool force) override { }
+    virtual void reload(const char *xpath) override { throwReadOnly("reload"); }
+    virtual void commit() override { throwReadOnly("commit"); }
+    virtual SessionId querySessionId() const override { return sessionId; }
+    virtual unsigned queryMode() const override { return mode; }
+    virtual void close(bool deleteRoot) override
+    {
+        if (deleteRoot)
+            throwReadOnly("close(deleteRoot)");
+        root.clear();
+    }
+    virtual SubscriptionId subscribe(ISDSConnectionSubscription &notify) override { throwReadOnly("subscribe"); }
+    virtual void unsubscribe(SubscriptionId id) override { throwReadOnly("unsubscribe"); }
+    virtual IPropertyTreeIterator *getElements(const char *xpath, IPTIteratorCodes flags) override
+    {
+        return root->getElements(xpath, flags);
+    }
+
+private:
+    [[noreturn]] void throwReadOnly(const char *op) const
+    {
+        throw MakeSDSException(SDSExcpt_BadMode, "%s not supported on snapshot connection to %s", op, xpath.get());
+    }
+
+    StringAttr xpath;
+    SessionId sessionId;
+    unsigned mode;
+    Linked<IPropertyTree> root;
+};
+
+IRemoteConnection *CClientSDSManager::connectSnapshot(const char *xpath, SessionId id, unsigned mode, unsigned timeout)
+{
+    if (mode & (RTM_LOCK_WRITE | RTM_LOCK_HOLD | RTM_CREATE_MASK | RTM_DELETE_ON_DISCONNECT))
+        throw MakeSDSException(SDSExcpt_BadMode, "RTM_SNAPSHOT cannot be combined with lock, create or delete modes, connecting to %s, mode=%x", xpath, mode);
+    if (!snapshotAvailable)
+        return connect(xpath, id, (mode & ~RTM_SNAPSHOT) | RTM_SUB, timeout);
+
     CCycleTimer elapsedTime(recordingEvents());
+    CMessageBuffer mb;
+    mb.append((int)DAMP_SDSCMD_GETSNAPSHOT);
+    mb.append(xpath);
+
+    size32_t sendSize = mb.length();
+    if (!sendRequest(mb, true))
+        throw MakeSDSException(SDSExcpt_FailedToCommunicateWithServer, ", snapshot of %s", xpath);
+
+    SdsReply replyMsg;
+    mb.read((int &)replyMsg);
+
+    CSnapshotConnection *conn = NULL;
+    switch (replyMsg)
+    {
+        case DAMP_SDSREPLY_OK:
+        {
+            Owned<CSnapshotRemoteTree> tree = new CSnapshotRemoteTree();
+            tree->deserializeRT(mb);
+            conn = new CSnapshotConnection(xpath, id, mode, tree);
+            break;
+        }
+        case DAMP_SDSREPLY_EMPTY:
+            break;
+        case DAMP_SDSREPLY_ERROR:
+            throwMbException("SDS Reply Error ", mb);
+        default:
+            assertex(false);
+    }
+
+    if (unlikely(recordingEvents()))
+        queryRecorder().recordDaliConnect(xpath, 0, elapsedTime.elapsedNs(), sendSize + mb.length());
+
+    return conn;
+}
+
+IRemoteConnection *CClientSDSManager::connect(const char *xpath, SessionId id, unsigned mode, unsigned timeout)
+{
     if (0 == id || id != myProcessSession())
         throw MakeSDSException(SDSExcpt_InvalidSessionId, ", connecting to %s, sessionid=%" I64F "x", xpath, id);
+    if (RTM_MODE(mode, RTM_SNAPSHOT))
+        return connectSnapshot(xpath, id, mode, timeout);
+
+    CCycleTimer elapsedTime(recordingEvents());
 
     CMessageBuffer mb;
     mb.append((int)DAMP_SDSCMD_CONNECT | lazyExtFlag);
@@ -390,6 +390,7 @@ public:
     ~CClientSDSManager();
     StringBuffer &getInfo(SdsDiagCommand cmd, StringBuffer &out);
     bool sendRequest(CMessageBuffer &mb, bool throttle=false);
+    IRemoteConnection *connectSnapshot(const char *xpath, SessionId id, unsigned mode, unsigned timeout);
 
 // ISDSConnectionManager
     virtual CRemoteTreeBase *get(CRemoteConnection &connection, __int64 serverId);
@@ -430,6 +431,7 @@ private:
     Semaphore concurrentRequests;
     mutable IPropertyTree *properties;
     bool childrenCanBeMissing; // for backward compat servers <= 2.0
+    bool snapshotAvailable; // server supports RTM_SNAPSHOT connections
     unsigned lazyExtFlag; // for backward compat servers <= 3.3
 };
 
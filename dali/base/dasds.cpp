@@ -207,6 +207,8 @@ StringBuffer &getSdsCmdText(SdsCommand cmd, StringBuffer &ret)
             return ret.append("DAMP_SDSCMD_GETELEMENTSRAW");
         case DAMP_SDSCMD_GETCOUNT:
             return ret.append("DAMP_SDSCMD_GETCOUNT");
+        case DAMP_SDSCMD_GETSNAPSHOT:
+            return ret.append("DAMP_SDSCMD_GETSNAPSHOT");
         default:
             return ret.append("UNKNOWN");
     };
@@ -989,7 +991,7 @@ bool filesMatch(IFile *file1, IFile *file2, bool compareTimes=true)
     return false;
 }
 
-void writeDelta(StringBuffer &xml, IFile &iFile, const char *msg="", unsigned retrySecs=0, unsigned retryAttempts=10)
+void writeDelta(StringBuffer &xml, IFile &iFile, const char *msg="", unsigned retrySecs=0, unsigned retryAttempts=10, bool sync=false)
 {
     Owned<IException> exception;
     OwnedIFileIO iFileIO;
@@ -1004,7 +1006,10 @@ void writeDelta(StringBuffer &xml, IFile &iFile, const char *msg="", unsigned re
         header.append(deltaHeader);
         try
         {
-            iFileIO.setown(iFile.open(IFOreadwrite));
+            // If syncing, the appended deltas are synced before the header that describes them is rewritten, and the
+            // header is synced when the file is closed. The loader cannot recover a header that claims data which never
+            // reached the disk, so the two writes must not be reordered.
+            iFileIO.setown(iFile.open(IFOreadwrite, sync ? IFEsync : IFEnone));
             stream.setown(createIOStream(iFileIO));
             if (lastGood)
             {
@@ -1026,6 +1031,8 @@ void writeDelta(StringBuffer &xml, IFile &iFile, const char *msg="", unsigned re
             stream->write(xml.length(), xml.str());
             stream->flush();
             stream.clear();
+            if (sync)
+                iFileIO->flush();
             offset_t fLen = lastGood + xml.length();
             unsigned crc = crc32(xml.str(), xml.length(), startCrc);
             char *headerPtr = (char *)header.bufferBase();
@@ -1131,6 +1138,7 @@ class CDeltaWriter : implements IThreaded
     memsize_t transactionMaxMem = defaultDeltaMemMaxMB * 0x100000;
     unsigned totalQueueLimitHits = 0;
     unsigned saveThresholdSecs = 0;
+    bool syncDeltas = false;
     cycle_t lastSaveTime = 0;
     cycle_t thresholdDuration = 0;
 
@@ -1171,7 +1179,7 @@ class CDeltaWriter : implements IThreaded
             StringBuffer deltaFilename(dataPath);
             iStoreHelper->getCurrentDeltaFilename(deltaFilename);
             OwnedIFile iFile = createIFile(deltaFilename.str());
-            writeDelta(deltaXml, *iFile, "writeXml", 1, INFINITE);
+            writeDelta(deltaXml, *iFile, "writeXml", 1, INFINITE, syncDeltas);
         }
         catch (IException *e)
         {
@@ -1313,6 +1321,7 @@ public:
         transactionQueueLimit = config->getPropInt("sds/@deltaTransactionQueueLimit", defaultDeltaTransactionQueueLimit);
         unsigned deltaTransactionMaxMemMB = config->getPropInt("sds/@deltaTransactionMaxMemMB", defaultDeltaMemMaxMB);
         transactionMaxMem = (memsize_t)deltaTransactionMaxMemMB * 0x100000;
+        syncDeltas = config->getPropBool("sds/@deltaSync", false);
         if (saveThresholdSecs)
         {
             thresholdDuration = queryOneSecCycles() * saveThresholdSecs;
@@ -1329,6 +1338,7 @@ public:
             msg.append("<DISABLED>");
         else
             msg.append(transactionQueueLimit);
+        msg.appendf(", deltaSync=%s", boolToStr(syncDeltas));
         PROGLOG("%s", msg.str());
 
         if ((transactionQueueLimit > 1) && (transactionMaxMem > 0))
@@ -1412,7 +1422,8 @@ public:
 
                 if (aborted)
                     break;
-                // keep going whilst there's things pending
+                // keep going whilst there's things pending. Every transaction queued while the previous batch was being
+                // written (and synced, if deltaSync is enabled) is committed by the next single append and its syncs.
                 while (true)
                 {
                     // NB: ensure consistent lock ordering of blockedSaveCrit and pendingCrit
@@ -4000,6 +4011,7 @@ int CSDSTransactionServer::run()
                         case DAMP_SDSCMD_GETEXTVALUE:
                         case DAMP_SDSCMD_GETELEMENTSRAW:
                         case DAMP_SDSCMD_GETCOUNT:
+                        case DAMP_SDSCMD_GETSNAPSHOT:
                         {
                             mb.reset();
                             handler.handleMessage(mb);
@@ -4802,6 +4814,31 @@ void CSDSTransactionServer::processMessage(CMessageBuffer &mb)
                 mb.append(manager.queryCount(xpath));
                 break;
             }
+            case DAMP_SDSCMD_GETSNAPSHOT:
+            {
+                // Serves a read-only copy of the committed sub-tree.  Unlike a connect this does not register a
+                // connection, subscribe the session or queue on node locks, so readers are not held up by a
+                // connection holding an exclusive lock on the branch - only by the shared store lock.
+                TimingBlock connectTimingBlock(connectTimingStats);
+                mb.read(xpath);
+                if (queryTransactionLogging())
+                    transactionLog.log("xpath='%s'", xpath.get());
+                CHECKEDDALIREADLOCKBLOCK(manager.dataRWLock, readWriteTimeout);
+                const char *path = xpath.get();
+                if ('/' == *path)
+                    ++path;
+                CServerRemoteTree *root = manager.queryRoot();
+                CServerRemoteTree *tree = *path ? (CServerRemoteTree *)root->queryPropTree(path) : root;
+                mb.clear();
+                if (tree)
+                {
+                    mb.append((int)DAMP_SDSREPLY_OK);
+                    tree->serializeCutOffRT(mb, FETCH_ENTIRE, 0, true);
+                }
+                else
+                    mb.append((int)DAMP_SDSREPLY_EMPTY);
+                break;
+            }
             default:
                 throwUnexpected();
         }
@@ -7046,6 +7083,7 @@ IRemoteConnections *CCovenSDSManager::connect(IMultipleConnector *mConnect, Sess
 
 IRemoteConnection *CCovenSDSManager::connect(const char *xpath, SessionId id, unsigned mode, unsigned timeout)
 {
+    mode &= ~RTM_SNAPSHOT; // in-process connections read the store directly, so there is nothing to gain from a copy
     Owned<CLCLockBlock> lockBlock;
     Owned<LinkingCriticalBlock> connectCritBlock;
     if (!RTM_MODE(mode, RTM_INTERNAL))
@@ -32,6 +32,7 @@
 #define RTM_CREATE_ADD    (RTM_CREATE | 0x100)  // add to existing elements
 #define RTM_CREATE_QUERY  (RTM_CREATE | 0x200)  // creates branch if connect path doesn't exist
 #define RTM_DELETE_ON_DISCONNECT 0x400  // auto delete connection root on disconnection.
+#define RTM_SNAPSHOT    0x800       // read-only copy of the committed sub-tree, no lock or server-side connection is held
 
 
 #define RTM_LOCKBASIC_MASK  (RTM_LOCK_READ | RTM_LOCK_WRITE | RTM_LOCK_HOLD)
@@ -44,6 +45,7 @@
 #define SDS_SVER_MIN_APPEND_OPT "3.3"
 #define SDS_SVER_MIN_GETIDS "3.5"
 #define SDS_SVER_MIN_NODESUBSCRIBE "3.12"
+#define SDS_SVER_MIN_SNAPSHOT "3.22"
 
 
 enum SDSNotifyFlags { SDSNotify_None=0x00, SDSNotify_Data=0x01, SDSNotify_Structure=0x02, SDSNotify_Added=(SDSNotify_Structure+0x04), SDSNotify_Deleted=(SDSNotify_Structure+0x08), SDSNotify_Renamed=(SDSNotify_Structure+0x10) };
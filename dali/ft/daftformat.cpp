@@ -64,6 +64,16 @@ void CPartitioner::setAbort(IAbortRequestCallback * _abort)
     abortChecker = _abort;
 }
 
+bool CPartitioner::setPartitionChunk(unsigned _whichChunk, unsigned _numChunks)
+{
+    assertex(_whichChunk < _numChunks);
+    if (!canPartitionChunks() || target)
+        return false;
+    whichChunk = _whichChunk;
+    numChunks = _numChunks;
+    return true;
+}
+
 bool CPartitioner::isAborting()
 {
     return abortChecker && abortChecker->abortRequested();
@@ -107,7 +117,34 @@ void CPartitioner::commonCalcPartitions()
 
     JSON_DBGLOG("commonCalcPartitions: partSize:%lld, endOffset: %lld, firstSplit: %d, lastSplit: %d ",partSize ,endOffset, firstSplit, lastSplit);
 
-    if (!partSeparator.isEmpty() && appendingContent) //appending to existing content, add a separator if necessary
+    auto getSplitOffset = [&](unsigned split) -> offset_t
+    {
+        if (split == numParts)
+            return endOffset;
+        else if (partSize==0)
+            return (split * totalSize) / numParts;
+        else
+            return split * partSize;
+    };
+
+    // If this is one chunk of a source that is partitioned in parallel, only process the splits [chunkFirstSplit, chunkEndSplit)
+    unsigned chunkFirstSplit = firstSplit;
+    unsigned chunkEndSplit = lastSplit+1;
+    if (numChunks > 1)
+    {
+        unsigned numSplits = (lastSplit >= firstSplit) ? lastSplit - firstSplit + 1 : 0;
+        if (numSplits >= numChunks)
+        {
+            chunkFirstSplit = firstSplit + (unsigned)(((offset_t)numSplits * whichChunk) / numChunks);
+            chunkEndSplit = firstSplit + (unsigned)(((offset_t)numSplits * (whichChunk+1)) / numChunks);
+        }
+        else if (whichChunk != 0)
+            return; // Too few splits to share - the first chunk processes all of them
+    }
+    const bool isFirstChunk = (chunkFirstSplit == firstSplit);
+    const bool isLastChunk = (chunkEndSplit == lastSplit+1);
+
+    if (!partSeparator.isEmpty() && appendingContent && isFirstChunk) //appending to existing content, add a separator if necessary
     {
         Owned<PartitionPoint> separator = new PartitionPoint;
         separator->inputOffset = 0;
@@ -126,15 +163,21 @@ void CPartitioner::commonCalcPartitions()
     if (target)
         target->setOutput(0);
 
-    for (unsigned split=firstSplit; split <= lastSplit; split++)
+    unsigned split = chunkFirstSplit;
+    if (!isFirstChunk)
     {
-        offset_t splitPoint;
-        if (split == numParts)
-            splitPoint = endOffset;
-        else if (partSize==0)
-            splitPoint =  (split * totalSize) / numParts;
-        else
-            splitPoint =  split * partSize;
+        // The previous chunk ends at this split point, so locate it without generating a block
+        findSplitPoint(getSplitOffset(split), cursor);
+        startInputOffset = cursor.inputOffset;
+        startOutputOffset = cursor.outputOffset;
+        split++;
+    }
+
+    // The last chunk finishes with the block up to the end of the source, the others with the block up to the next chunk
+    const unsigned loopLastSplit = isLastChunk ? lastSplit : chunkEndSplit;
+    for (; split <= loopLastSplit; split++)
+    {
+        offset_t splitPoint = getSplitOffset(split);
         JSON_DBGLOG("commonCalcPartitions: split:%d, splitPoint: %lld",split ,splitPoint);
         findSplitPoint(splitPoint, cursor);
         const offset_t inputOffset = cursor.inputOffset;
@@ -155,6 +198,12 @@ void CPartitioner::commonCalcPartitions()
             throwAbortException();
     }
 
+    if (!isLastChunk)
+    {
+        killBuffer();
+        return;
+    }
+
     assertex(startInputOffset != endOffset || splitAfterPoint());
     findSplitPoint(endOffset, cursor);
     JSON_DBGLOG("commonCalcPartitions: lastSplit: %d, startInputOffset: %lld, thisOffset: %lld, thisHeaderSize: %d, startOutputOffset: %lld, cursor.outputOffset: %lld", lastSplit, startInputOffset, thisOffset, thisHeaderSize ,startOutputOffset, cursor.outputOffset);
@@ -1671,9 +1720,20 @@ size32_t XmlSplitter::getRecordSize(const byte * start, unsigned maxToRead, bool
     const byte * cur = start;
     const byte * end = start + maxToRead;
     bool inTag = false;
+    const bool canScanForTags = (utfFormat == UtfReader::Utf8);
 
     while (cur != end)
     {
+        //Outside a row tag only an opening or closing tag changes the state, and both start with '<', so use a
+        //bulk scan to skip the content rather than matching every character.
+        if (canScanForTags && !inTag && (*cur != '<'))
+        {
+            const byte * nextTag = (const byte *)memchr(cur, '<', end-cur);
+            if (!nextTag)
+                break;
+            cur = nextTag;
+        }
+
         unsigned matchLen;
         unsigned match = matcher.getMatch(end-cur, (const char *)cur, matchLen);
         switch (match & 255)
@@ -2881,4 +2941,201 @@ protected:
 CPPUNIT_TEST_SUITE_REGISTRATION(CsvDeduceLineTest);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(CsvDeduceLineTest, "CsvDeduceLineTest");
 
+//----------------------------------------------------------------------------
+// Unit tests for partitioning a source in chunks
+//----------------------------------------------------------------------------
+
+class PartitionChunkTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(PartitionChunkTest);
+        CPPUNIT_TEST(testFixedChunks);
+        CPPUNIT_TEST(testCsvChunks);
+        CPPUNIT_TEST(testUtfChunks);
+        CPPUNIT_TEST(testXmlChunks);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+    template <typename CREATE>
+    void partition(PartitionPointArray & results, CREATE create, const RemoteFilename & name, offset_t totalSize, offset_t offset, offset_t size, unsigned headerSize, unsigned numParts, unsigned numChunks)
+    {
+        for (unsigned chunk=0; chunk < numChunks; chunk++)
+        {
+            Owned<IFormatPartitioner> partitioner = create();
+            partitioner->setPartitionRange(totalSize, offset, size, headerSize, numParts);
+            partitioner->setSource(1, name, false, nullptr);
+            if (numChunks > 1)
+                CPPUNIT_ASSERT(partitioner->setPartitionChunk(chunk, numChunks));
+            partitioner->calcPartitions(nullptr);
+            partitioner->getResults(results);
+        }
+    }
+
+    // Check that partitioning the source in any number of chunks generates exactly the same partition as processing
+    // it serially.  The source is offset within a larger logical input when offset != 0.
+    template <typename CREATE>
+    void checkChunks(CREATE create, const RemoteFilename & name, offset_t totalSize, offset_t offset, offset_t size, unsigned headerSize, unsigned numParts)
+    {
+        PartitionPointArray expected;
+        partition(expected, create, name, totalSize, offset, size, headerSize, numParts, 1);
+        CPPUNIT_ASSERT(expected.ordinality() > 1);
+        for (unsigned numChunks=2; numChunks <= numParts+1; numChunks++)
+        {
+            PartitionPointArray actual;
+            partition(actual, create, name, totalSize, offset, size, headerSize, numParts, numChunks);
+            CPPUNIT_ASSERT_EQUAL(expected.ordinality(), actual.ordinality());
+            ForEachItemIn(i, expected)
+            {
+                PartitionPoint & cur = expected.item(i);
+                PartitionPoint & chunked = actual.item(i);
+                CPPUNIT_ASSERT_EQUAL(cur.whichOutput, chunked.whichOutput);
+                CPPUNIT_ASSERT_EQUAL(cur.inputOffset, chunked.inputOffset);
+                CPPUNIT_ASSERT_EQUAL(cur.inputLength, chunked.inputLength);
+                CPPUNIT_ASSERT_EQUAL(cur.outputLength, chunked.outputLength);
+            }
+        }
+    }
+
+    // Check a source file of variable length records, which the split points (and so the chunk boundaries) fall within
+    template <typename CREATE>
+    void checkFileChunks(CREATE create, const char * filename, const MemoryBuffer & header, const MemoryBuffer & rows, const MemoryBuffer & footer)
+    {
+        StringBuffer path;
+        makeAbsolutePath(filename, path);
+        Owned<IFile> file = createIFile(path);
+        {
+            Owned<IFileIO> io = file->open(IFOcreate);
+            io->write(0, header.length(), header.toByteArray());
+            io->write(header.length(), rows.length(), rows.toByteArray());
+            io->write(header.length() + rows.length(), footer.length(), footer.toByteArray());
+        }
+        RemoteFilename name;
+        name.setLocalPath(path);
+        offset_t size = rows.length();
+        try
+        {
+            checkChunks(create, name, size, 0, size, header.length(), 7);
+            checkChunks(create, name, size + 300000, 300000, size, header.length(), 13);
+        }
+        catch (...)
+        {
+            file->remove();
+            throw;
+        }
+        file->remove();
+    }
+
+    static void appendText(MemoryBuffer & out, const char * text, unsigned unitSize)
+    {
+        for (const char * cur = text; *cur; cur++)
+        {
+            out.append(*cur);
+            for (unsigned i=1; i < unitSize; i++)
+                out.append((char)0);
+        }
+    }
+
+    static void createRows(MemoryBuffer & out, const char * rowFormat, unsigned unitSize)
+    {
+        StringBuffer padding;
+        for (unsigned i=0; i < 2000; i++)
+        {
+            padding.clear().appendN((i * 7919) % 400, 'x');
+            VStringBuffer row(rowFormat, i, padding.str(), i*7);
+            appendText(out, row, unitSize);
+        }
+    }
+
+    void testFixedChunks()
+    {
+        RemoteFilename name;
+        name.setLocalPath("chunktest.d00");
+        auto create = []() { return new CSimpleFixedPartitioner(10, true); };
+        checkChunks(create, name, 100000, 0, 100000, 0, 7);
+        checkChunks(create, name, 100000, 30000, 70000, 0, 7);
+        checkChunks(create, name, 100000, 30000, 20000, 0, 13);
+    }
+
+    void testCsvChunks()
+    {
+        FileFormat format(FFTcsv);
+        format.maxRecordSize = 8192;
+        MemoryBuffer header, rows, footer;
+        createRows(rows, "%u,\"name, %s\",%u\n", 1);
+        checkFileChunks([&]() { return new CCsvQuickPartitioner(format, true); }, "partitionchunktest.csv", header, rows, footer);
+    }
+
+    void testUtfChunks()
+    {
+        FileFormat format(FFTutf8);
+        format.maxRecordSize = 8192;
+        MemoryBuffer header, rows, footer;
+        createRows(rows, "%u,%s,%u\r\n", 1);
+        checkFileChunks([&]() { return new CUtfQuickPartitioner(format, true); }, "partitionchunktest.utf8", header, rows, footer);
+
+        // Split points have to be aligned to the character size
+        FileFormat format16(FFTutf16le);
+        format16.maxRecordSize = 8192;
+        MemoryBuffer rows16;
+        createRows(rows16, "%u,%s,%u\n", 2);
+        checkFileChunks([&]() { return new CUtfQuickPartitioner(format16, true); }, "partitionchunktest.utf16", header, rows16, footer);
+    }
+
+    void testXmlChunks()
+    {
+        FileFormat format(FFTutf8);
+        format.markup = FMTxml;
+        format.rowTag.set("row");
+        format.maxRecordSize = 8192;
+        MemoryBuffer header, rows, footer;
+        appendText(header, "<Dataset>\n", 1);
+        createRows(rows, "<row id=\"%u\"><name>%s</name><value>%u</value></row>\n", 1);
+        appendText(footer, "</Dataset>\n", 1);
+        checkFileChunks([&]() { return new CXmlQuickPartitioner(format, true); }, "partitionchunktest.xml", header, rows, footer);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PartitionChunkTest);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(PartitionChunkTest, "PartitionChunkTest");
+
+//----------------------------------------------------------------------------
+// Unit tests for XmlSplitter::getRecordSize
+//----------------------------------------------------------------------------
+
+class XmlSplitterTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(XmlSplitterTest);
+        CPPUNIT_TEST(testRecordSize);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+    FileFormat createFormat(FileFormatType type)
+    {
+        FileFormat format;
+        format.type = type;
+        format.markup = FMTxml;
+        format.rowTag.set("row");
+        format.maxRecordSize = 8192;
+        return format;
+    }
+
+    void testRecordSize()
+    {
+        FileFormat format = createFormat(FFTutf8);
+        XmlSplitter splitter(format);
+
+        const char * data = "<row id=\"1\"><rowx>a &lt; b</rowx><name>x</name></row>\n<row>next</row>";
+        size32_t expected = strchr(data, '\n') + 1 - data;
+        CPPUNIT_ASSERT_EQUAL(expected, splitter.getRecordSize((const byte *)data, strlen(data), true));
+
+        const char * empty = "<row id=\"2\"/>\r\n<row/>";
+        CPPUNIT_ASSERT_EQUAL((size32_t)(strchr(empty, '\n') + 1 - empty), splitter.getRecordSize((const byte *)empty, strlen(empty), true));
+
+        const char * partial = "<row><name>no end";
+        CPPUNIT_ASSERT_EQUAL((size32_t)strlen(partial), splitter.getRecordSize((const byte *)partial, strlen(partial), false));
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(XmlSplitterTest);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(XmlSplitterTest, "XmlSplitterTest");
+
 #endif // _USE_CPPUNIT
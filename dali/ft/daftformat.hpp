@@ -62,6 +62,9 @@ public:
     virtual void setRecordStructurePresent(bool _recordStructurePresent) = 0;
     virtual void getRecordStructure(StringBuffer & _recordStructure) = 0;
     virtual void setAbort(IAbortRequestCallback * _abort) = 0;
+    // Only calculate the split points within one of _numChunks contiguous chunks of the source, so that several
+    // partitioners can process a large source in parallel.  Returns false if the partitioner cannot do this.
+    virtual bool setPartitionChunk(unsigned _whichChunk, unsigned _numChunks) = 0;
 };
 
 interface IFormatProcessor : public IFormatPartitioner
@@ -53,10 +53,12 @@ public:
     virtual void setRecordStructurePresent(bool _recordStructurePresent);
     virtual void getRecordStructure(StringBuffer & _recordStructure);
     virtual void setAbort(IAbortRequestCallback * _abort);
+    virtual bool setPartitionChunk(unsigned _whichChunk, unsigned _numChunks);
 
 protected:
     virtual void findSplitPoint(offset_t curOffset, PartitionCursor & cursor) = 0;
     virtual bool splitAfterPoint() { return false; }
+    virtual bool canPartitionChunks() { return false; }     // can findSplitPoint() start at an arbitrary split?
     virtual void killBuffer() = 0;
 
     void commonCalcPartitions();
@@ -78,6 +80,8 @@ protected:
     unsigned                    numParts;
     bool                        partitioning;
     IAbortRequestCallback *     abortChecker = nullptr;
+    unsigned                    whichChunk = 0;
+    unsigned                    numChunks = 1;
 };
 
 //---------------------------------------------------------------------------
@@ -103,6 +107,7 @@ public:
 
 protected:
     virtual void findSplitPoint(offset_t curOffset, PartitionCursor & cursor);
+    virtual bool canPartitionChunks() { return true; }
 
 protected:
     unsigned                    recordSize;
@@ -293,6 +298,7 @@ public:
 protected:
     virtual void findSplitPoint(offset_t curOffset, PartitionCursor & cursor);
     virtual bool splitAfterPoint() { return true; }
+    virtual bool canPartitionChunks() { return true; }
 
 protected:
     bool                        noTranslation;
@@ -345,6 +351,7 @@ public:
 protected:
     virtual void findSplitPoint(offset_t curOffset, PartitionCursor & cursor);
     virtual bool splitAfterPoint() { return true; }
+    virtual bool canPartitionChunks() { return true; }
 
 protected:
     bool                        noTranslation;
@@ -697,6 +704,7 @@ public:
 protected:
     virtual void findSplitPoint(offset_t curOffset, PartitionCursor & cursor);
     virtual bool splitAfterPoint() { return true; }
+    virtual bool canPartitionChunks() { return true; }
 
 protected:
     bool                        noTranslation;
@@ -721,6 +729,7 @@ public:
     virtual void setRecordStructurePresent(bool _recordStructurePresent);
     virtual void getRecordStructure(StringBuffer & _recordStructure);
     virtual void setAbort(IAbortRequestCallback * _abort) { /*UNIMPLEMENTED;*/ }
+    virtual bool setPartitionChunk(unsigned _whichChunk, unsigned _numChunks) { return false; }
 
 protected:
     void callRemote();
@@ -88,6 +88,7 @@ inline void setCanAccessDirectly(RemoteFilename & file)
 #define ANnoRecover         "@noRecover"
 #define ANnosplit           "@nosplit"
 #define ANnosplit2          "@noSplit"
+#define ANpartitionChunks   "@partitionChunks"
 #define ANprefix            "@prefix"
 #define ANpull              "@pull"
 #define ANpush              "@push"
@@ -1365,29 +1366,33 @@ void FileSprayer::calculateSprayPartition()
     StringBuffer remoteFilename;
     ForEachItemIn(idx, sources)
     {
-        IFormatPartitioner * partitioner = createPartitioner(idx, calcOutput, numParts);
-        partitioner->setAbort(&fileSprayerAbortChecker);
-        partitioners.append(*partitioner);
+        //Large sources are split into chunks which are partitioned in parallel.  The chunks are added in order, so
+        //the results are identical to partitioning the whole source at once.
+        unsigned numChunks = numPartitionChunks(sources.item(idx), calcOutput, numParts);
+        for (unsigned chunk=0; chunk < numChunks; chunk++)
+        {
+            IFormatPartitioner * partitioner = createPartitioner(idx, calcOutput, numParts);
+            partitioner->setAbort(&fileSprayerAbortChecker);
+            partitioners.append(*partitioner);
+            if ((numChunks > 1) && !partitioner->setPartitionChunk(chunk, numChunks))
+            {
+                assertex(chunk == 0);
+                break;
+            }
+        }
     }
 
     unsigned numProcessors = partitioners.ordinality();
     unsigned numThreads = numPartitionThreads(numProcessors);
 
-    //Throttle maximum number of concurrent transfers by starting n threads, and
-    //then waiting for one to complete before going on to the next
-    Semaphore sem;
-    unsigned goIndex;
-    for (goIndex=0; goIndex < numThreads; goIndex++)
-        partitioners.item(goIndex).calcPartitions(&sem);
-
-    for (; goIndex<numProcessors; goIndex++)
+    //Local partitioners calculate synchronously, remote partitioners signal the semaphore once they complete,
+    //so run n at a time on separate threads and wait for each to finish.
+    asyncFor(numProcessors, numThreads, true, [&](unsigned i)
     {
+        Semaphore sem;
+        partitioners.item(i).calcPartitions(&sem);
         sem.wait();
-        partitioners.item(goIndex).calcPartitions(&sem);
-    }
-
-    for (unsigned waitCount=0; waitCount < numThreads; waitCount++)
-        sem.wait();
+    });
 
     ForEachItemIn(idx2, partitioners)
         partitioners.item(idx2).getResults(partition);
@@ -2621,6 +2626,25 @@ bool FileSprayer::needToCalcOutput()
     return !usePullOperation() || options->getPropBool(ANverify);
 }
 
+unsigned FileSprayer::numPartitionChunks(const FilePartInfo & cur, bool calcOutput, unsigned numParts)
+{
+    //Only worth splitting large sources, and only valid if a record cannot span more than one split point
+    const offset_t minPartitionChunkSize = 0x10000000; // 256MB
+    if (calcOutput || (numParts <= 1) || (cur.size < 2 * minPartitionChunkSize))
+        return 1;
+    offset_t partSize = totalSize / numParts;
+    if (partSize < 4 * (offset_t)srcFormat.maxRecordSize)
+        return 1;
+
+    unsigned maxChunks = options->getPropInt(ANpartitionChunks, getComponentConfigSP()->getPropInt("@partitionChunks", 8));
+    offset_t numChunks = cur.size / minPartitionChunkSize;
+    if (partSize && (numChunks > cur.size / partSize))
+        numChunks = cur.size / partSize;
+    if (numChunks > maxChunks)
+        numChunks = maxChunks;
+    return numChunks ? (unsigned)numChunks : 1;
+}
+
 unsigned FileSprayer::numPartitionThreads(unsigned limit)
 {
     unsigned maxConnections = options->getPropInt(ANmaxConnections, limit);
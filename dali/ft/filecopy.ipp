@@ -259,6 +259,7 @@ protected:
     void locateJsonHeader(IFileIO * io, unsigned headerSize, offset_t & headerLength, offset_t & footerLength);
     void locateContentHeader(IFileIO * io, unsigned headerSize, offset_t & headerLength, offset_t & footerLength);
     bool needToCalcOutput();
+    unsigned numPartitionChunks(const FilePartInfo & cur, bool calcOutput, unsigned numParts);
     unsigned numPartitionThreads(unsigned limit);
     void performTransfer();
     void pullParts();
@@ -30,6 +30,7 @@
 
 #include "portlist.h"
 #include "dadfs.hpp"
+#include "thorcommon.hpp"
 #include "dasess.hpp"
 #include "daclient.hpp"
 #include "mpcomm.hpp"
@@ -265,6 +266,7 @@ public:
     virtual void popCluster() override;
     virtual bool allowAccess(const char * category, bool isSigned) override;
     virtual IHqlExpression *lookupDFSlayout(const char *filename, IErrorReceiver &errs, const ECLlocation &location, bool isOpt) const override;
+    virtual unsigned __int64 lookupDFSfileHash(const char *filename) const override;
     virtual unsigned lookupClusterSize() const override;
     virtual void getTargetPlatform(StringBuffer & result) override;
     virtual IInterface * getGitUpdateLock(const char * key) override;
@@ -351,6 +353,7 @@ public:
     virtual void popCluster() override;
     virtual bool allowAccess(const char * category, bool isSigned) override;
     virtual IHqlExpression *lookupDFSlayout(const char *filename, IErrorReceiver &errs, const ECLlocation &location, bool isOpt) const override;
+    virtual unsigned __int64 lookupDFSfileHash(const char *filename) const override;
     virtual unsigned lookupClusterSize() const override;
     virtual void getTargetPlatform(StringBuffer & result) override;
     virtual IInterface * getGitUpdateLock(const char * key) override;
@@ -2408,6 +2411,11 @@ IHqlExpression * EclCompileInstance::lookupDFSlayout(const char *filename, IErro
     return eclcc.lookupDFSlayout(filename, errs, location, isOpt);
 }
 
+unsigned __int64 EclCompileInstance::lookupDFSfileHash(const char *filename) const
+{
+    return eclcc.lookupDFSfileHash(filename);
+}
+
 void EclCompileInstance::getTargetPlatform(StringBuffer & result)
 {
     SCMStringBuffer targetText;
@@ -2544,6 +2552,35 @@ IInterface * EclCC::getGitUpdateLock(const char * path)
 }
 
 
+unsigned __int64 EclCC::lookupDFSfileHash(const char *filename) const
+{
+    CriticalBlock b(dfsCrit);
+    if (!checkDaliConnected())
+        return 0;
+
+    StringBuffer lookupName;
+    if (filename[0]=='~')
+        filename++;
+    else if (!optScope.isEmpty())
+    {
+         lookupName.appendf("%s::%s", optScope.str(), filename);
+         filename = lookupName.str();
+    }
+
+    try
+    {
+        Owned<IDistributedFile> dfsFile = wsdfs::lookup(filename, udesc, AccessMode::tbdRead, false, false, nullptr, defaultPrivilegedUser, INFINITE);
+        if (dfsFile)
+            return crcLogicalFileTime(dfsFile, 0, filename);
+    }
+    catch (IException *E)
+    {
+        // The hash is only used to distinguish versions of a file, so treat a file that cannot be accessed as missing
+        E->Release();
+    }
+    return 0;
+}
+
 IHqlExpression *EclCC::lookupDFSlayout(const char *filename, IErrorReceiver &errs, const ECLlocation &location, bool isOpt) const
 {
     CriticalBlock b(dfsCrit);  // Overkill at present but maybe one day codegen will start threading?
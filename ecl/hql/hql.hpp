@@ -217,6 +217,12 @@ interface ICodegenContextCallback : public IInterface
      * @param location      Location to use when reporting errors
      */
     virtual IHqlExpression *lookupDFSlayout(const char *filename, IErrorReceiver &errs, const ECLlocation &location, bool isOpt) const = 0;
+    /**
+     * Lookup a file in DFS and return a hash of its current version, or 0 if it cannot be determined
+     *
+     * @param filename      The logical filename. Scope expansion/~ removal should not have been done
+     */
+    virtual unsigned __int64 lookupDFSfileHash(const char *filename) const = 0;
     /**
      * Return number of nodes for the current cluster, via Dali lookup, or 0 if cannot be determined.
      *
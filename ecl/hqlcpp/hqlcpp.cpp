@@ -1963,6 +1963,8 @@ void HqlCppTranslator::cacheOptions()
         DebugOption(options.newIndexReadMapping, "newIndexReadMapping", false), // Not yet enabled due to problems with merging mapped fields and roxie/thor integration
         DebugOption(options.checkDuplicateThreshold, "checkDuplicateThreshold", 0), // If non zero, create a warning if duplicates > this percentage increase
         DebugOption(options.checkDuplicateMinActivities, "checkDuplicateMinActivities", 100),
+        DebugOption(options.autoPersist, "autoPersist", false),              // Implicitly PERSIST expensive datasets so identical work can be reused by later workunits
+        DebugOption(options.autoPersistMinActivities, "autoPersistMinActivities", 5),
         DebugOption(options.diskReadsAreSimple, "diskReadsAreSimple", false), // Not yet enabled - needs filters to default to generating keyed info first
         DebugOption(options.allKeyedFiltersOptional, "allKeyedFiltersOptional", false),
         DebugOption(options.genericDiskReadWrites, "genericDiskReadWrites", false), // Can be enabled for hthor, but locking not currently supported
@@ -641,6 +641,7 @@ struct HqlCppOptions
     unsigned            reportDFSinfo = 0;
     unsigned            checkDuplicateThreshold = 0;
     unsigned            checkDuplicateMinActivities = 0;
+    unsigned            autoPersistMinActivities = 0;
     CompilerType        targetCompiler = GccCppCompiler;
     DBZaction           divideByZeroAction = DBZnone;
     unsigned            maxOptimizeSize = 0;
@@ -844,6 +845,7 @@ struct HqlCppOptions
     bool                addDefaultBloom = false;
     bool                newDiskReadMapping = false;
     bool                transformNestedSequential = false;
+    bool                autoPersist = false;
     bool                preserveWhenSequential = false;
     bool                forceAllProjectedDiskSerialized = false;
     bool                newIndexReadMapping = false;
@@ -2010,6 +2012,7 @@ protected:
     void doReportWarning(WarnErrorCategory category, ErrorSeverity explicitSeverity, IHqlExpression * location, unsigned id, const char * msg);
 
     void optimizePersists(HqlExprArray & exprs);
+    void autoPersistDatasets(HqlExprArray & exprs);
     void optimizeSingleGraphGlobals(WorkflowItem & curWorkflow);
     IHqlExpression * convertSetResultToExtract(IHqlExpression * expr);
     void allocateSequenceNumbers(HqlExprArray & exprs);
@@ -149,6 +149,7 @@ public:
     virtual void popCluster() override {}
     virtual bool allowAccess(const char * category, bool isSigned) override { return true; }
     virtual IHqlExpression *lookupDFSlayout(const char *filename, IErrorReceiver &errs, const ECLlocation &location, bool isOpt) const override { return nullptr; }
+    virtual unsigned __int64 lookupDFSfileHash(const char *filename) const override { return 0; }
     virtual unsigned lookupClusterSize() const override { return 0; }
     virtual IInterface * getGitUpdateLock(const char * key) override { return nullptr; }
 
@@ -687,6 +688,11 @@ bool HqlDllGenerator::doCompile(ICppCompiler * compiler)
     unsigned maxThreads = wu->getDebugValueInt("maxCompileThreads", defaultMaxCompileThreads);
     compiler->setMaxCompileThreads(maxThreads);
 
+    StringBuffer objectCacheDir;
+    wu->getDebugValue("compileCacheDir", StringBufferAdaptor(objectCacheDir));
+    if (objectCacheDir.length())
+        compiler->setObjectCacheDir(objectCacheDir);
+
     bool debug = wu->getDebugValueBool("debugQuery", false);
     bool debugLibrary = debug;  // should be wu->getDebugValueBool("debugLibrary", IS_DEBUG_BUILD); change for 3.8
     compiler->setDebug(debug);
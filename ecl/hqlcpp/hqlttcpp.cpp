@@ -5606,6 +5606,151 @@ void optimizeActivities(unsigned wfid, HqlExprArray & exprs, bool optimizeCountC
     transformer.transformRoot(exprs);
 }
 
+//------------------------------------------------------------------------
+
+static HqlTransformerInfo autoPersistTransformerInfo("AutoPersistTransformer");
+AutoPersistTransformer::AutoPersistTransformer(ICodegenContextCallback * _ctxCallback, const char * _scope, unsigned _minActivities)
+: NewHqlTransformer(autoPersistTransformerInfo), ctxCallback(_ctxCallback), scope(_scope), minActivities(_minActivities)
+{
+}
+
+void AutoPersistTransformer::analyseExpr(IHqlExpression * expr)
+{
+    expr = expr->queryBody();
+    AutoPersistInfo * extra = queryBodyExtra(expr);
+    extra->noteUsed();
+    if (alreadyVisited(expr))
+        return;
+
+    node_operator op = expr->getOperator();
+    switch (op)
+    {
+    case no_colon:
+        //Shared datasets within an existing workflow item can be persisted, but the item is evaluated independently,
+        //and anything that uses it depends on the workflow (e.g., a stored value) rather than just the input files.
+        queryBodyExtra(expr->queryChild(0))->workflowValue = true;
+        NewHqlTransformer::analyseExpr(expr);
+        extra->unsafe = true;
+        return;
+    case no_table:
+    case no_keyindex:
+    case no_newkeyindex:
+        {
+            IHqlExpression * filename = queryTableFilename(expr);
+            IHqlExpression * mode = (op == no_table) ? expr->queryChild(2) : nullptr;
+            if (!filename || !filename->queryValue() || (mode && mode->getOperator() == no_pipe))
+                extra->unsafe = true;
+            else
+                extra->readsFile = true;
+            break;
+        }
+    case no_getresult:
+    case no_workunit_dataset:
+    case no_getgraphresult:
+    case no_getgraphloopresult:
+    case no_libraryinput:
+    case no_param:
+    case no_pipe:
+    case no_httpcall:
+    case no_soapcall:
+    case no_soapcall_ds:
+    case no_newsoapcall:
+    case no_newsoapcall_ds:
+        extra->unsafe = true;
+        break;
+    }
+
+    NewHqlTransformer::analyseExpr(expr);
+    ForEachChild(i, expr)
+        extra->inherit(queryBodyExtra(expr->queryChild(i)));
+    if (expr->isDataset() && (op != no_table) && (extra->numActivities != (unsigned)-1))
+        extra->numActivities++;
+}
+
+bool AutoPersistTransformer::isWorthPersisting(IHqlExpression * expr)
+{
+    if (!expr->isDataset() || expr->isFunction())
+        return false;
+    //Other expressions refer to the fields of the dataset via its selector, so only replace datasets that are their own selector
+    if (expr->queryNormalizedSelector() != expr)
+        return false;
+
+    AutoPersistInfo * extra = queryBodyExtra(expr);
+    if (extra->unsafe || !extra->readsFile || (extra->numActivities < minActivities))
+        return false;
+
+    if (!isIndependentOfScope(expr) || containsWorkflow(expr) || usesRuntimeContext(expr))
+        return false;
+    if (isVolatile(expr) || containsSideEffects(expr) || isContextDependent(expr))
+        return false;
+    return true;
+}
+
+unsigned __int64 AutoPersistTransformer::getAutoPersistHash(IHqlExpression * expr)
+{
+    //The ecl crc is only 32bits, so also hash the regenerated ecl to make a collision between different datasets unlikely
+    StringBuffer ecl;
+    toECL(expr, ecl, true);
+    unsigned __int64 hash = rtlHash64VStr(ecl.str(), HASH64_INIT);
+    unsigned crc = getExpressionCRC(expr);
+    hash = rtlHash64Data(sizeof(crc), &crc, hash);
+
+    //Include the current version of each input file, so that the persists for different versions of the inputs do not
+    //replace each other.  If a file has changed since the query was compiled the persist check still rebuilds it.
+    DependenciesUsed dependencies(false);
+    gatherDependencies(expr, dependencies, GatherFileRead);
+    ForEachItemIn(i, dependencies.tablesRead)
+    {
+        StringBuffer filename;
+        getStringValue(filename, &dependencies.tablesRead.item(i));
+        unsigned __int64 fileHash = ctxCallback ? ctxCallback->lookupDFSfileHash(filename) : 0;
+        hash = rtlHash64VStr(filename.str(), hash);
+        hash = rtlHash64Data(sizeof(fileHash), &fileHash, hash);
+    }
+    return hash;
+}
+
+IHqlExpression * AutoPersistTransformer::createAutoPersist(IHqlExpression * expr, IHqlExpression * transformed)
+{
+    //The code hash is checked again before the persist is reused, so a hash collision causes a rebuild, not a wrong result
+    StringBuffer name;
+    name.append("~").append(scope).appendf("::%016" I64F "x", getAutoPersistHash(expr));
+
+    HqlExprArray persistArgs;
+    persistArgs.append(*createConstant(name.str()));
+    persistArgs.append(*createAttribute(expireAtom));       // sasha removes any that have not been used within the expiry period
+    persistArgs.append(*createAttribute(singleAtom));       // the name already depends on the code hash
+
+    HqlExprArray args;
+    args.append(*LINK(transformed));
+    args.append(*createValue(no_persist, makeVoidType(), persistArgs));
+    args.append(*createAttribute(_original_Atom, LINK(expr)));
+    return createWrapper(no_colon, args);
+}
+
+IHqlExpression * AutoPersistTransformer::createTransformed(IHqlExpression * expr)
+{
+    //Persist the largest expensive dataset, rather than each of the datasets it is built from, since another workunit
+    //is most likely to reuse the complete result.  Shared datasets are also persisted, since each use can reuse them.
+    //The value of an existing workflow item is already evaluated separately.  Datasets that are only used once have a
+    //single consumer, so whether they are within a persisted dataset does not depend on the order they are transformed.
+    bool candidate = (expr == expr->queryBody()) && isWorthPersisting(expr);
+    AutoPersistInfo * extra = queryBodyExtra(expr);
+    bool wrap = candidate && !extra->workflowValue && (extra->isShared() || !withinPersist);
+
+    bool savedWithinPersist = withinPersist;
+    if (candidate)
+        withinPersist = true;
+    OwnedHqlExpr transformed = NewHqlTransformer::createTransformed(expr);
+    withinPersist = savedWithinPersist;
+
+    //Wrap the body, and then reapply any annotations.  Shared datasets within it have already been wrapped, so the
+    //persist reuses their persists when it is rebuilt.
+    if (wrap)
+        return createAutoPersist(expr, transformed);
+    return transformed.getClear();
+}
+
 IHqlExpression * GlobalAttributeInfo::queryAlias(IHqlExpression * value)
 {
     if (!aliasName)
@@ -14395,6 +14540,20 @@ void HqlCppTranslator::checkWorkflowDuplication(HqlExprArray & exprs)
 }
 
 
+void HqlCppTranslator::autoPersistDatasets(HqlExprArray & exprs)
+{
+    StringBuffer scope;
+    wu()->getDebugValue("autoPersistScope", StringBufferAdaptor(scope));
+    if (!scope.length())
+        scope.append("auto::persist");
+
+    AutoPersistTransformer transformer(ctxCallback, scope, options.autoPersistMinActivities);
+    HqlExprArray transformed;
+    transformer.analyseArray(exprs, 0);
+    transformer.transformRoot(exprs, transformed);
+    replaceArray(exprs, transformed);
+}
+
 void HqlCppTranslator::substituteClusterSize(HqlExprArray & exprs)
 {
     unsigned numNodes = options.specifiedClusterSize;
@@ -14505,6 +14664,13 @@ void HqlCppTranslator::applyGlobalOptimizations(HqlExprArray & exprs)
         replaceArray(exprs, folded);
     }
 
+    //Persists are not supported by roxie, and libraries cannot contain workflow
+    if (options.autoPersist && !targetRoxie() && !outputLibrary)
+    {
+        autoPersistDatasets(exprs);
+        traceExpressions("afterAutoPersist", exprs);
+    }
+
     traceExpressions("alloc", exprs);
     checkNormalized(exprs);
     modifyOutputLocations(exprs);
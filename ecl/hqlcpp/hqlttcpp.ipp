@@ -437,6 +437,62 @@ protected:
     bool optimizeNonEmpty;
 };
 
+//---------------------------------------------------------------------------
+
+class AutoPersistInfo : public NewTransformInfo
+{
+public:
+    AutoPersistInfo(IHqlExpression * _original) : NewTransformInfo(_original) { setNumUses(0); }
+
+    inline bool isShared() { return getNumUses() > 1; }
+    inline void noteUsed() { setNumUses(getNumUses()+1); }
+    inline void inherit(const AutoPersistInfo * other)
+    {
+        numActivities = (numActivities + other->numActivities < numActivities) ? (unsigned)-1 : numActivities + other->numActivities;
+        readsFile = readsFile || other->readsFile;
+        unsafe = unsafe || other->unsafe;
+    }
+
+private:
+    inline byte getNumUses() const { return spareByte1; }
+    inline void setNumUses(unsigned value) { spareByte1 = value < 100 ? value : 100; }
+    using NewTransformInfo::spareByte1;     // used to hold a numUses()
+
+public:
+    unsigned numActivities = 0;     // An estimate - shared inputs are counted once for each use
+    bool readsFile = false;
+    bool unsafe = false;            // reads something other than a fixed logical file, so the result cannot be reused
+    bool workflowValue = false;     // the value of an existing workflow item
+};
+
+//Wrap the largest expensive datasets, and any expensive datasets that are shared by several activities, that only
+//depend on fixed logical files in a PERSIST named after a hash of the expression and the current versions of the input files.  The persist check (expression crc
+//+ input file crcs) then allows a later workunit that generates an identical dataset to reuse the materialised result
+//instead of recalculating it.
+class AutoPersistTransformer : public NewHqlTransformer
+{
+public:
+    AutoPersistTransformer(ICodegenContextCallback * _ctxCallback, const char * _scope, unsigned _minActivities);
+
+    virtual void analyseExpr(IHqlExpression * expr);
+    virtual IHqlExpression * createTransformed(IHqlExpression * expr);
+
+protected:
+    virtual ANewTransformInfo * createTransformInfo(IHqlExpression * expr)  { return CREATE_NEWTRANSFORMINFO(AutoPersistInfo, expr); }
+
+    IHqlExpression * createAutoPersist(IHqlExpression * expr, IHqlExpression * transformed);
+    unsigned __int64 getAutoPersistHash(IHqlExpression * expr);
+    bool isWorthPersisting(IHqlExpression * expr);
+
+    AutoPersistInfo * queryBodyExtra(IHqlExpression * expr)    { return (AutoPersistInfo *)queryTransformExtra(expr->queryBody()); }
+
+protected:
+    ICodegenContextCallback * ctxCallback;
+    StringAttr scope;
+    unsigned minActivities;
+    bool withinPersist = false;
+};
+
 
 //---------------------------------------------------------------------------
 
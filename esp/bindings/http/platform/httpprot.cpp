@@ -115,6 +115,8 @@ void CHttpProtocol::init(IPropertyTree * cfg, const char * process, const char *
     }
 
     initPersistentHandler(proc_cfg);
+    if (proc_cfg)
+        m_deferIdleAccepts = proc_cfg->getPropBool("@deferIdleAccepts", false);
 
     Owned<IPropertyTree> proto_cfg = getProtocolConfig(cfg, protocol, process);
     if(proto_cfg)
@@ -155,6 +157,15 @@ bool CHttpProtocol::notifySelected(ISocket *sock,unsigned selected, IPersistentH
                 DBGLOG("HTTP connection from %s:%d on %s socket", peername, port, persistentHandler?"persistent":"new");
     #endif          
 
+                // A newly accepted connection that has not sent anything yet is parked with the persistent handler,
+                // which selects on it with all other idle connections and only dispatches it to a worker thread
+                // once request data arrives (or closes it if it stays idle), so slow clients do not tie up threads.
+                if (!persistentHandler && m_deferIdleAccepts && persistentEnabled() && (accepted->wait_read(0) == 0))
+                {
+                    addPersistent(accepted);
+                    return false;
+                }
+
                 if(m_maxConcurrentThreads > 0)
                 {
                     // Using Threading pool instead of generating one thread per request.
@@ -113,6 +113,7 @@ class esp_http_decl CHttpProtocol : public CEspProtocol
 private:
     int m_maxConcurrentThreads;
     int m_threadCreateTimeout;
+    bool m_deferIdleAccepts = false;
 public:
     CHttpProtocol();
     virtual ~CHttpProtocol();
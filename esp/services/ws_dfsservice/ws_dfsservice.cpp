@@ -17,10 +17,16 @@
 
 #pragma warning (disable : 4786)
 
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "jflz.hpp"
 #include "jstring.hpp"
 
 #include "daaudit.hpp"
+#include "dasds.hpp"
 #include "dautils.hpp"
 #include "dadfs.hpp"
 #include "dafdesc.hpp"
@@ -43,6 +49,269 @@ static unsigned __int64 getLockId(unsigned __int64 leaseId)
 }
 
 
+static constexpr unsigned defaultFileCacheMaxAgeSecs = 0; // disabled unless configured
+static constexpr unsigned defaultFileCacheMaxFiles = 10000;
+
+/*
+ * Cache of file trees fetched from Dali, keyed by logical name.
+ * Each scope that has cached files holds a single SDS subscription on its Dali branch. Any change within
+ * the scope drops the scope (and its subscription), so a subsequent lookup re-fetches its files from Dali.
+ * Each scope is given a new version whenever it is created or changed. A lookup whose scope version moved on
+ * whilst fetching is not cached. Files are evicted least recently used first, and a scope is unsubscribed
+ * as soon as it has no cached files, so the number of subscriptions is bounded by the number of files.
+ */
+class CFileTreeCache : public CInterface, implements ISDSSubscription
+{
+    typedef std::pair<std::string, std::string> CFileKey; // scope xpath, logical name
+    struct CCachedFile
+    {
+        Linked<IPropertyTree> tree;
+        unsigned cachedTime = 0;
+        std::list<CFileKey>::iterator lruPos;
+    };
+    struct CCachedScope
+    {
+        SubscriptionId subId = 0;
+        unsigned version = 0;
+        std::unordered_map<std::string, CCachedFile> files;
+    };
+    std::unordered_map<std::string, CCachedScope> scopes;
+    std::unordered_map<SubscriptionId, std::string> subscriptions;
+    std::list<CFileKey> lru; // most recently used first
+    std::vector<SubscriptionId> unsubscribePending;
+    mutable CriticalSection crit;
+    unsigned maxAgeMs = 0;
+    unsigned maxFiles = 0;
+    unsigned nextVersion = 0;
+
+    // NB: the following are called whilst crit is held. SDS subscriptions are never altered whilst crit is held,
+    // since a notification may be waiting for crit - they are removed later by flushUnsubscribes().
+    void removeScope(std::unordered_map<std::string, CCachedScope>::iterator scopeIt)
+    {
+        for (auto &file: scopeIt->second.files)
+            lru.erase(file.second.lruPos);
+        if (scopeIt->second.subId)
+        {
+            subscriptions.erase(scopeIt->second.subId);
+            unsubscribePending.push_back(scopeIt->second.subId);
+        }
+        scopes.erase(scopeIt);
+    }
+    void removeFile(const CFileKey &key)
+    {
+        auto scopeIt = scopes.find(key.first);
+        if (scopeIt == scopes.end())
+            return;
+        CCachedScope &scope = scopeIt->second;
+        auto fileIt = scope.files.find(key.second);
+        if (fileIt == scope.files.end())
+            return;
+        lru.erase(fileIt->second.lruPos);
+        scope.files.erase(fileIt);
+        if (scope.files.empty())
+            removeScope(scopeIt);
+    }
+    void flushUnsubscribes()
+    {
+        std::vector<SubscriptionId> goers;
+        {
+            CriticalBlock b(crit);
+            goers.swap(unsubscribePending);
+        }
+        for (SubscriptionId subId: goers)
+            unsubscribeScope(subId);
+    }
+
+protected:
+    // Access to Dali - virtual so that the cache can be tested without one
+    virtual IPropertyTree *fetchFileTree(const char *logicalName, IUserDescriptor *userDesc)
+    {
+        return queryDistributedFileDirectory().getFileTree(logicalName, userDesc, AccessMode::readMeta);
+    }
+    virtual void checkAccess(const char *logicalName, IUserDescriptor *userDesc)
+    {
+        checkLogicalName(logicalName, userDesc, true, false, false, nullptr);
+    }
+    virtual SubscriptionId subscribeScope(const char *scopeXPath)
+    {
+        try
+        {
+            return querySDS().subscribe(scopeXPath, *this, true);
+        }
+        catch (IException *e)
+        {
+            EXCLOG(e, "CFileTreeCache: failed to subscribe");
+            e->Release();
+            return 0;
+        }
+    }
+    virtual void unsubscribeScope(SubscriptionId subId)
+    {
+        try
+        {
+            querySDS().unsubscribe(subId);
+        }
+        catch (IException *e)
+        {
+            EXCLOG(e, "CFileTreeCache: failed to unsubscribe");
+            e->Release();
+        }
+    }
+
+public:
+    IMPLEMENT_IINTERFACE;
+
+    CFileTreeCache(unsigned maxAgeSecs, unsigned _maxFiles) : maxAgeMs(maxAgeSecs * 1000), maxFiles(_maxFiles)
+    {
+    }
+    ~CFileTreeCache()
+    {
+        clear();
+    }
+    void clear()
+    {
+        {
+            CriticalBlock b(crit);
+            while (!scopes.empty())
+                removeScope(scopes.begin());
+        }
+        flushUnsubscribes();
+    }
+    bool isEnabled() const
+    {
+        return (maxAgeMs != 0) && (maxFiles != 0);
+    }
+    unsigned queryNumFiles() const
+    {
+        CriticalBlock b(crit);
+        return lru.size();
+    }
+    unsigned queryNumScopes() const
+    {
+        CriticalBlock b(crit);
+        return scopes.size();
+    }
+    IPropertyTree *getFileTree(const char *logicalName, IUserDescriptor *userDesc)
+    {
+        if (!isEnabled())
+            return fetchFileTree(logicalName, userDesc);
+
+        CDfsLogicalFileName lfn;
+        lfn.set(logicalName);
+        StringBuffer scopeXPath;
+        lfn.makeScopeQuery(scopeXPath, true);
+        CFileKey key(scopeXPath.str(), lfn.get());
+
+        Owned<IPropertyTree> tree;
+        bool subscribed = false;
+        unsigned version = 0;
+        {
+            CriticalBlock b(crit);
+            auto scopeIt = scopes.find(key.first);
+            if (scopeIt != scopes.end())
+            {
+                CCachedScope &scope = scopeIt->second;
+                auto fileIt = scope.files.find(key.second);
+                if (fileIt != scope.files.end())
+                {
+                    if (msTick() - fileIt->second.cachedTime < maxAgeMs)
+                    {
+                        lru.splice(lru.begin(), lru, fileIt->second.lruPos);
+                        // NB: caller may alter the tree, hence a copy is returned
+                        tree.setown(createPTreeFromIPT(fileIt->second.tree));
+                    }
+                    else
+                        removeFile(key);
+                }
+                else
+                {
+                    subscribed = true;
+                    version = scope.version;
+                }
+            }
+        }
+        if (tree)
+        {
+            // the cached file tree may have been fetched with another user's credentials, so check this user's scope permissions
+            checkAccess(logicalName, userDesc);
+            return tree.getClear();
+        }
+        flushUnsubscribes();
+
+        if (!subscribed)
+        {
+            // The subscription must be in place before fetching, so that any change made after the fetch is notified
+            SubscriptionId subId = subscribeScope(scopeXPath);
+            if (subId)
+            {
+                CriticalBlock b(crit);
+                auto scopeIt = scopes.find(key.first);
+                if (scopeIt == scopes.end())
+                {
+                    CCachedScope &scope = scopes[key.first];
+                    scope.subId = subId;
+                    scope.version = ++nextVersion;
+                    subscriptions[subId] = key.first;
+                    version = scope.version;
+                }
+                else
+                {
+                    // another thread subscribed concurrently
+                    unsubscribePending.push_back(subId);
+                    version = scopeIt->second.version;
+                }
+                subscribed = true;
+            }
+        }
+
+        tree.setown(fetchFileTree(logicalName, userDesc));
+        if (subscribed)
+        {
+            CriticalBlock b(crit);
+            auto scopeIt = scopes.find(key.first);
+            if ((scopeIt != scopes.end()) && (scopeIt->second.version == version)) // no change notified whilst fetching
+            {
+                CCachedScope &scope = scopeIt->second;
+                if (tree)
+                {
+                    auto fileIt = scope.files.find(key.second);
+                    if (fileIt == scope.files.end())
+                    {
+                        fileIt = scope.files.emplace(key.second, CCachedFile()).first;
+                        lru.push_front(key);
+                        fileIt->second.lruPos = lru.begin();
+                    }
+                    else
+                        lru.splice(lru.begin(), lru, fileIt->second.lruPos);
+                    fileIt->second.tree.setown(createPTreeFromIPT(tree));
+                    fileIt->second.cachedTime = msTick();
+                    while (lru.size() > maxFiles)
+                    {
+                        CFileKey goer = lru.back();
+                        removeFile(goer);
+                    }
+                }
+                else if (scope.files.empty())
+                    removeScope(scopeIt);
+            }
+        }
+        flushUnsubscribes();
+        return tree.getClear();
+    }
+// ISDSSubscription
+    virtual void notify(SubscriptionId id, const char *xpath, SDSNotifyFlags flags, unsigned valueLen, const void *valueData) override
+    {
+        CriticalBlock b(crit);
+        auto it = subscriptions.find(id);
+        if (it == subscriptions.end())
+            return;
+        auto scopeIt = scopes.find(it->second);
+        if (scopeIt != scopes.end())
+            removeScope(scopeIt);
+    }
+};
+static Owned<CFileTreeCache> fileTreeCache;
+
 enum LfnMetaOpts : byte
 {
     LfnMOptNone   = 0x00,
@@ -59,7 +328,7 @@ static void populateLFNMeta(IUserDescriptor *userDesc, const char *logicalName,
 
     assertex(!lfn.isMulti()); // not supported, don't think needs to be/will be.
 
-    Owned<IPropertyTree> tree = queryDistributedFileDirectory().getFileTree(logicalName, userDesc, AccessMode::readMeta);
+    Owned<IPropertyTree> tree = fileTreeCache->getFileTree(logicalName, userDesc);
     if (!tree)
         return;
     if (hasMask(opts, LfnMOptRemap))
@@ -152,11 +421,23 @@ static void populateLFNMeta(IUserDescriptor *userDesc, const char *logicalName,
 }
 
 
+CWsDfsEx::~CWsDfsEx()
+{
+    // release the cache's Dali subscriptions whilst Dali is still connected
+    fileTreeCache.clear();
+}
+
 void CWsDfsEx::init(IPropertyTree *cfg, const char *process, const char *service)
 {
     DBGLOG("Initializing %s service [process = %s]", service, process);
     VStringBuffer xpath("Software/EspProcess/EspBinding[@service=\"%s\"]/@protocol", service);
     isHttps = strsame("https", cfg->queryProp(xpath));
+
+    Owned<IPropertyTree> compConfig = getComponentConfig();
+    unsigned cacheMaxAgeSecs = compConfig->getPropInt("@fileCacheMaxAgeSecs", defaultFileCacheMaxAgeSecs);
+    unsigned cacheMaxFiles = compConfig->getPropInt("@fileCacheMaxFiles", defaultFileCacheMaxFiles);
+    fileTreeCache.setown(new CFileTreeCache(cacheMaxAgeSecs, cacheMaxFiles));
+    DBGLOG("%s file meta cache: maxAgeSecs=%u, maxFiles=%u", service, cacheMaxAgeSecs, cacheMaxFiles);
 }
 
 bool CWsDfsEx::onGetLease(IEspContext &context, IEspLeaseRequest &req, IEspLeaseResponse &resp)
@@ -255,3 +536,139 @@ bool CWsDfsEx::onDFSFileLookup(IEspContext &context, IEspDFSFileLookupRequest &r
     return true;
 }
 
+
+#ifdef _USE_CPPUNIT
+#include "unittests.hpp"
+
+class DfsFileTreeCacheTests : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(DfsFileTreeCacheTests);
+    CPPUNIT_TEST(testHit);
+    CPPUNIT_TEST(testInvalidation);
+    CPPUNIT_TEST(testEviction);
+    CPPUNIT_TEST(testSubscribeFailure);
+    CPPUNIT_TEST_SUITE_END();
+
+    // Replaces Dali with an in-memory set of subscriptions, counting the fetches made
+    class CTestFileTreeCache : public CFileTreeCache
+    {
+    public:
+        CTestFileTreeCache(unsigned maxFiles) : CFileTreeCache(300, maxFiles) {}
+        ~CTestFileTreeCache()
+        {
+            clear();
+        }
+
+        void notifyScope(const char *logicalName)
+        {
+            CDfsLogicalFileName lfn;
+            lfn.set(logicalName);
+            StringBuffer scopeXPath;
+            lfn.makeScopeQuery(scopeXPath, true);
+            for (auto &sub: subscribed)
+            {
+                if (sub.second == scopeXPath.str())
+                    notify(sub.first, scopeXPath, SDSNotify_Data, 0, nullptr);
+            }
+        }
+
+        unsigned numFetches = 0;
+        bool failSubscribe = false;
+        std::map<SubscriptionId, std::string> subscribed;
+
+    protected:
+        virtual IPropertyTree *fetchFileTree(const char *logicalName, IUserDescriptor *userDesc) override
+        {
+            numFetches++;
+            Owned<IPropertyTree> tree = createPTree("File");
+            tree->setProp("@name", logicalName);
+            return tree.getClear();
+        }
+        virtual void checkAccess(const char *logicalName, IUserDescriptor *userDesc) override
+        {
+        }
+        virtual SubscriptionId subscribeScope(const char *scopeXPath) override
+        {
+            if (failSubscribe)
+                return 0;
+            SubscriptionId subId = ++nextSubId;
+            subscribed[subId] = scopeXPath;
+            return subId;
+        }
+        virtual void unsubscribeScope(SubscriptionId subId) override
+        {
+            CPPUNIT_ASSERT(subscribed.erase(subId) == 1);
+        }
+
+        SubscriptionId nextSubId = 0;
+    };
+
+    void getFile(CTestFileTreeCache &cache, const char *logicalName)
+    {
+        Owned<IPropertyTree> tree = cache.getFileTree(logicalName, nullptr);
+        CPPUNIT_ASSERT(tree);
+        CPPUNIT_ASSERT(strieq(logicalName, tree->queryProp("@name")));
+    }
+
+public:
+    void testHit()
+    {
+        CTestFileTreeCache cache(10);
+        getFile(cache, "test::scope1::file1");
+        getFile(cache, "test::scope1::file1");
+        CPPUNIT_ASSERT_EQUAL(1U, cache.numFetches);
+        getFile(cache, "test::scope1::file2");
+        CPPUNIT_ASSERT_EQUAL(2U, cache.numFetches);
+        // Both files share the subscription on their scope
+        CPPUNIT_ASSERT_EQUAL((size_t)1, cache.subscribed.size());
+        CPPUNIT_ASSERT_EQUAL(2U, cache.queryNumFiles());
+    }
+
+    void testInvalidation()
+    {
+        CTestFileTreeCache cache(10);
+        getFile(cache, "test::scope1::file1");
+        getFile(cache, "test::scope2::file1");
+        cache.notifyScope("test::scope1::file1");
+        CPPUNIT_ASSERT_EQUAL(1U, cache.queryNumScopes());
+        getFile(cache, "test::scope1::file1");
+        getFile(cache, "test::scope2::file1");
+        CPPUNIT_ASSERT_EQUAL(3U, cache.numFetches);
+        // The invalidated scope's subscription is released and a new one taken when it is next cached
+        CPPUNIT_ASSERT_EQUAL((size_t)2, cache.subscribed.size());
+    }
+
+    void testEviction()
+    {
+        CTestFileTreeCache cache(2);
+        getFile(cache, "test::scope1::file1");
+        getFile(cache, "test::scope2::file1");
+        getFile(cache, "test::scope1::file1");      // scope2::file1 is now least recently used
+        getFile(cache, "test::scope3::file1");
+        CPPUNIT_ASSERT_EQUAL(2U, cache.queryNumFiles());
+        CPPUNIT_ASSERT_EQUAL(2U, cache.queryNumScopes());
+        getFile(cache, "test::scope1::file1");
+        CPPUNIT_ASSERT_EQUAL(3U, cache.numFetches);
+        // The evicted file's scope has no files left, so its subscription has gone
+        CPPUNIT_ASSERT_EQUAL((size_t)2, cache.subscribed.size());
+        getFile(cache, "test::scope2::file1");
+        CPPUNIT_ASSERT_EQUAL(4U, cache.numFetches);
+        cache.clear();
+        CPPUNIT_ASSERT(cache.subscribed.empty());
+    }
+
+    void testSubscribeFailure()
+    {
+        CTestFileTreeCache cache(10);
+        cache.failSubscribe = true;
+        getFile(cache, "test::scope1::file1");
+        getFile(cache, "test::scope1::file1");
+        // Files cannot be cached without a subscription to invalidate them
+        CPPUNIT_ASSERT_EQUAL(2U, cache.numFetches);
+        CPPUNIT_ASSERT_EQUAL(0U, cache.queryNumScopes());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DfsFileTreeCacheTests);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(DfsFileTreeCacheTests, "DfsFileTreeCacheTests");
+#endif
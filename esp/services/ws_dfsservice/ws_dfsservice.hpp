@@ -28,7 +28,7 @@ class CWsDfsEx : public CWsDfs
 {
     bool isHttps = false;
 public:
-    virtual ~CWsDfsEx() {}
+    virtual ~CWsDfsEx();
     virtual void init(IPropertyTree *cfg, const char *process, const char *service);
     virtual bool onGetLease(IEspContext &context, IEspLeaseRequest &req, IEspLeaseResponse &resp);
     virtual bool onKeepAlive(IEspContext &context, IEspKeepAliveRequest &req, IEspKeepAliveResponse &resp);
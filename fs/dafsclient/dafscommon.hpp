@@ -19,7 +19,7 @@
 #define DAFSCOMMON_HPP
 
 #define DAFILESRV_VERSION_MAJOR 2
-#define DAFILESRV_VERSION_MINOR 7
+#define DAFILESRV_VERSION_MINOR 8
 #define MAJORMINOR(MAJOR, MINOR) MAJOR ## MINOR
 #define DAFILESRV_VERSION_JOIN(X, Y) MAJORMINOR(X, Y)
 #define DAFILESRV_VERSION DAFILESRV_VERSION_JOIN(DAFILESRV_VERSION_MAJOR, DAFILESRV_VERSION_MINOR)
@@ -93,6 +93,8 @@ enum
     RFCStreamReadJSON = '{',
 // 2.6
     RFCFtSlaveCmd,
+// 2.8
+    RFCreadmulti,
     RFCmaxnormal,
     RFCmax,
     RFCunknown = 255 // 0 would have been more sensible, but can't break backward compatibility
@@ -42,6 +42,7 @@
 #include "remoteerr.hpp"
 #include <atomic>
 #include <string>
+#include <unordered_map>
 
 #include "dafscommon.hpp"
 #include "rmtclient_impl.hpp"
@@ -1379,24 +1380,33 @@ unsigned getRemoteVersion(ISocket *origSock, StringBuffer &ver)
     return ret;
 }
 
+static CriticalSection remoteVersionCrit;
+static std::unordered_map<std::string, unsigned> remoteVersionCache;
+
 unsigned getCachedRemoteVersion(IDaFsConnection &daFsConnection)
 {
-    /* JCSMORE - add a SocketEndpoint->version cache
-     * Idea being, that clients will want to determine version and differentiate what they send
-     * But do not want the cost of asking each time!
-     * So have a 'getRemoteVersion' call ask once and store version, so next time it returns cached answer.
+    /* Clients want to determine the version to differentiate what they send, but do not want the cost of asking each time,
+     * so the version is asked for once per endpoint and the answer cached.
      *
      * May want to have timeout on cache entries, but can be long. Don't expect remote side to change often within lifetime of client.
      */
-
-    // JCSMORE TBD (properly!)
-
-    // 1st check ep in cache using:
-    //   daFsConnect.queryEp()
-    // else
+    StringBuffer epText;
+    daFsConnection.queryEp().getEndpointHostText(epText);
+    {
+        CriticalBlock block(remoteVersionCrit);
+        auto match = remoteVersionCache.find(epText.str());
+        if (match != remoteVersionCache.end())
+            return match->second;
+    }
 
     StringBuffer ver;
-    return daFsConnection.getVersion(ver);
+    unsigned version = daFsConnection.getVersion(ver);
+    if (version) // 0 means the version could not be determined, so ask again next time
+    {
+        CriticalBlock block(remoteVersionCrit);
+        remoteVersionCache[epText.str()] = version;
+    }
+    return version;
 }
 
 unsigned getCachedRemoteVersion(const SocketEndpoint &ep, bool secure)
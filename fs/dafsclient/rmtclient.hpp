@@ -35,6 +35,7 @@
 
 #define DAFILESRV_STREAMREAD_MINVERSION 22
 #define DAFILESRV_STREAMGENERAL_MINVERSION 25
+#define DAFILESRV_READMULTI_MINVERSION 28
 
 typedef int RemoteFileIOHandle;
 // backward compatible modes
@@ -17,6 +17,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "platform.h"
 #include "portlist.h"
@@ -1295,6 +1296,18 @@ protected:
     compatIFSHmode compatmode;
     IFEflags extraFlags = IFEnone;
     bool disconnectonexit;
+    std::atomic<bool> multiReadSupported{true};
+    std::atomic<bool> multiReadChecked{false};
+
+    struct MultiReadRequest
+    {
+        offset_t pos;
+        size32_t len;
+        unsigned firstRange;
+        unsigned lastRange;
+    };
+    static constexpr size32_t maxMultiReadSize = 0x1000000;  // must be less than maxMultiReadSize in dafilesrv
+    static constexpr unsigned maxMultiReadRanges = 1024;
 public:
     CRemoteFileIO(CRemoteFile *_parent)
         : parent(_parent), ioReadCycles(0), ioWriteCycles(0), ioReadBytes(0), ioWriteBytes(0), ioReads(0), ioWrites(0), ioRetries(0)
@@ -1473,6 +1486,144 @@ public:
     {
     }
 
+    bool checkMultiReadSupported()
+    {
+        if (!multiReadChecked)
+        {
+            unsigned version = getCachedRemoteVersion(*parent);
+            if (0 == version) // could not determine the version - retry next time
+                return false;
+            multiReadSupported = (version >= DAFILESRV_READMULTI_MINVERSION);
+            multiReadChecked = true;
+        }
+        return multiReadSupported;
+    }
+
+    void readRanges(unsigned num, RemoteReadRange *ranges)
+    {
+        if (checkMultiReadSupported())
+        {
+            //Coalesce adjacent ranges, and send as many ranges per request as the size limits allow
+            for (unsigned i=0; i < num; i++)
+                ranges[i].got = 0;
+            std::vector<MultiReadRequest> requests;
+            size32_t batchSize = 0;
+            for (unsigned i=0; i < num; i++)
+            {
+                RemoteReadRange &range = ranges[i];
+                if (0 == range.len)
+                    continue;
+                if (range.len > maxMultiReadSize)
+                {
+                    range.got = read(range.pos, range.len, range.data);
+                    continue;
+                }
+                if (!requests.empty())
+                {
+                    MultiReadRequest &prev = requests.back();
+                    if ((prev.pos + prev.len == range.pos) && (range.len <= maxMultiReadSize - batchSize))
+                    {
+                        prev.len += range.len;
+                        prev.lastRange = i;
+                        batchSize += range.len;
+                        continue;
+                    }
+                    if ((range.len > maxMultiReadSize - batchSize) || (requests.size() == maxMultiReadRanges))
+                    {
+                        if (!doReadRanges(requests, ranges))
+                            break;
+                        requests.clear();
+                        batchSize = 0;
+                    }
+                }
+                requests.push_back({range.pos, range.len, i, i});
+                batchSize += range.len;
+            }
+            if (multiReadSupported && (requests.empty() || doReadRanges(requests, ranges)))
+                return;
+        }
+        //dafilesrv is too old to support RFCreadmulti - read the ranges one at a time
+        for (unsigned i=0; i < num; i++)
+        {
+            RemoteReadRange &range = ranges[i];
+            range.got = read(range.pos, range.len, range.data);
+        }
+    }
+
+    // Returns false if the server does not support multiple range reads
+    bool doReadRanges(const std::vector<MultiReadRequest> &requests, RemoteReadRange *ranges)
+    {
+        unsigned tries=0;
+        CCycleTimer timer;
+        for (;;)
+        {
+            try
+            {
+                MemoryBuffer sendBuffer;
+                initSendBuffer(sendBuffer);
+                MemoryBuffer replyBuffer;
+                sendBuffer.append((RemoteFileCommandType)RFCreadmulti).append(handle).append((unsigned)requests.size());
+                for (const MultiReadRequest &request : requests)
+                    sendBuffer.append(request.pos).append(request.len);
+                parent->sendRemoteCommand(sendBuffer, replyBuffer, false);
+
+                __uint64 totalGot = 0;
+                for (const MultiReadRequest &request : requests)
+                {
+                    size32_t got;
+                    replyBuffer.read(got);
+                    if ((got>replyBuffer.remaining())||(got>request.len))
+                    {
+                        PROGLOG("Read beyond buffer %d,%d,%d",got,replyBuffer.remaining(),request.len);
+                        throw createDafsException(RFSERR_ReadFailed, "Read beyond buffer");
+                    }
+                    const byte *data = (const byte *)replyBuffer.readDirect(got);
+                    totalGot += got;
+                    //Split the data between the ranges that were coalesced into this request
+                    for (unsigned i=request.firstRange; i <= request.lastRange; i++)
+                    {
+                        RemoteReadRange &range = ranges[i];
+                        size32_t copyLen = std::min(got, range.len);
+                        memcpy(range.data, data, copyLen);
+                        range.got = copyLen;
+                        data += copyLen;
+                        got -= copyLen;
+                    }
+                }
+                ioReadCycles.fetch_add(timer.elapsedCycles());
+                ioReadBytes.fetch_add(totalGot);
+                ioReads.fetch_add(requests.size());
+                if (tries)
+                    ioRetries.fetch_add(tries);
+                return true;
+            }
+            catch (IDAFS_Exception *e)
+            {
+                if (e->errorCode() != RFSERR_InvalidCommand)
+                    throw;
+                e->Release();
+                multiReadSupported = false;
+                return false;
+            }
+            catch (IJSOCK_Exception *e)
+            {
+                EXCLOG(e,"CRemoteFileIO::readRanges");
+                if (++tries > 3)
+                {
+                    ioRetries.fetch_add(tries);
+                    throw;
+                }
+                WARNLOG("Retrying read of %s (%d)",parent->queryLocalName(),tries);
+                Owned<IException> exc = e;
+                if (!reopen())
+                {
+                    ioRetries.fetch_add(tries);
+                    throw exc.getClear();
+                }
+            }
+        }
+    }
+
     const void *doRead(offset_t pos, size32_t len, MemoryBuffer &replyBuffer, size32_t &got, void *dstbuf)
     {
         unsigned tries=0;
@@ -1863,6 +2014,18 @@ void disconnectRemoteIoOnExit(IFileIO *fileio,bool set)
     clientDisconnectRemoteIoOnExit(fileio,set);
 }
 
+void readFileRanges(IFileIO *fileio, unsigned num, RemoteReadRange *ranges)
+{
+    CRemoteFileIO *cfileio = QUERYINTERFACE(fileio,CRemoteFileIO);
+    if (cfileio)
+    {
+        cfileio->readRanges(num, ranges);
+        return;
+    }
+    for (unsigned i=0; i < num; i++)
+        ranges[i].got = ranges[i].len ? fileio->read(ranges[i].pos, ranges[i].len, ranges[i].data) : 0;
+}
+
 
 bool resetRemoteFilename(IFile *file, const char *newname)
 {
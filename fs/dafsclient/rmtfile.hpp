@@ -68,6 +68,17 @@ extern DAFSCLIENT_API void remoteExtractBlobElements(const char * prefix, const
 extern DAFSCLIENT_API void disconnectRemoteFile(IFile *file);
 extern DAFSCLIENT_API void disconnectRemoteIoOnExit(IFileIO *fileio,bool set=true);
 
+struct RemoteReadRange
+{
+    offset_t pos = 0;
+    size32_t len = 0;
+    void * data = nullptr;
+    size32_t got = 0;       // number of bytes read, set by readFileRanges
+};
+// Reads several ranges of a file.  Ranges of a remote file are read from dafilesrv with as few requests as possible,
+// adjacent ranges being coalesced into a single read.  Other files are read a range at a time.
+extern DAFSCLIENT_API void readFileRanges(IFileIO *fileio, unsigned num, RemoteReadRange *ranges);
+
 extern DAFSCLIENT_API bool resetRemoteFilename(IFile *file, const char *newname); // returns false if not remote
 
 
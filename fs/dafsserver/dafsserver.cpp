@@ -260,6 +260,7 @@ const char *RFCStrings[] =
     RFCText(RFCStreamGeneral),
     RFCText(RFCStreamReadJSON),
     RFCText(RFCFtSlaveCmd),
+    RFCText(RFCreadmulti),
     RFCText(RFCmaxnormal),
 };
 
@@ -1536,6 +1537,7 @@ class CRemoteDiskReadActivity : public CRemoteStreamReadBaseActivity
     bool inputGrouped = false;
     bool eogPending = false;
     bool someInGroup = false;
+    size32_t fixedFilterRowSize = 0;
     Owned<const IDynamicTransform> translator;
 
     virtual bool refreshCursor() override
@@ -1570,6 +1572,51 @@ public:
         if (!outMeta)
             outMeta.set(inMeta);
         translator.setown(createRecordTranslator(outMeta->queryRecordAccessor(true), *record));
+
+        // Fixed size rows that are filtered can be filtered a batch at a time, see nextFilteredFixedRow()
+        if (!inputGrouped && (filterRow || applySampling))
+            fixedFilterRowSize = inMeta->getFixedSize();
+    }
+    // Filter the rows that are already in the stream buffer in place, and skip all rows that do not match
+    // in one go, so that rejected rows are never prefetched or translated.
+    const void *nextFilteredFixedRow(MemoryBufferBuilder &outBuilder, size32_t &retSz)
+    {
+        while (processed < chooseN)
+        {
+            if (prefetchBuffer.eos())
+                break;
+            const byte *batch = prefetchBuffer.peek(fixedFilterRowSize);
+            size32_t available = (size32_t)prefetchBuffer.maxAvailable();
+            if (unlikely(available < fixedFilterRowSize))
+                throw makeStringExceptionV(0, "Partial row of %u bytes at the end of '%s' (row size %u)", available, fileName.get(), fixedFilterRowSize);
+
+            unsigned numRows = available / fixedFilterRowSize;
+            unsigned next = 0;
+            while ((next < numRows) && !fieldFilterMatch(batch + next * fixedFilterRowSize))
+                next++;
+            if (next)
+                prefetchBuffer.skipBytes(next * fixedFilterRowSize);
+            if (next == numRows)
+                continue;
+
+            size32_t rowSz = translator->translate(outBuilder, *this, prefetchBuffer.queryRow());
+            prefetchBuffer.skipBytes(fixedFilterRowSize);
+            const void *ret = outBuilder.getSelf();
+            outBuilder.finishRow(rowSz);
+            if (rowSz)
+            {
+                processed++;
+                retSz = rowSz;
+                return ret;
+            }
+        }
+        if (!fetching)
+        {
+            eofSeen = true;
+            close();
+        }
+        retSz = 0;
+        return nullptr;
     }
 // IRemoteReadActivity impl.
     virtual const void *nextRow(MemoryBufferBuilder &outBuilder, size32_t &retSz) override
@@ -1582,6 +1629,8 @@ public:
             return nullptr;
         }
         checkOpen();
+        if (fixedFilterRowSize)
+            return nextFilteredFixedRow(outBuilder, retSz);
         while (!eofSeen && (processed < chooseN))
         {
             while (!prefetchBuffer.eos())
@@ -4114,6 +4163,42 @@ public:
         reply.writeEndianDirect(posOfLength,sizeof(numRead),&numRead);
     }
 
+    void cmdReadMulti(MemoryBuffer & msg, MemoryBuffer & reply, CClientStats &stats)
+    {
+        // Limit the size of the reply - clients coalesce and batch their reads below this size
+        constexpr unsigned __int64 maxMultiReadSize = 0x4000000;
+        int handle;
+        unsigned num;
+        msg.read(handle).read(num);
+        Owned<IFileIO> fileio;
+        checkFileIOHandle(reply, handle, fileio);
+
+        reply.append((unsigned)RFEnoerror);
+        unsigned __int64 totalLen = 0;
+        unsigned __int64 totalRead = 0;
+        for (unsigned i=0; i < num; i++)
+        {
+            __int64 pos;
+            size32_t len;
+            msg.read(pos).read(len);
+            totalLen += len;
+            if (totalLen > maxMultiReadSize)
+                throw createDafsExceptionV(RFSERR_ReadFailed, "RFCreadmulti: total read length exceeds %" I64F "u", maxMultiReadSize);
+            //read each range directly into the reply buffer, following its length
+            size32_t numRead;
+            unsigned posOfLength = reply.length();
+            reply.reserve(sizeof(numRead));
+            void *data = reply.reserve(len);
+            numRead = fileio->read(pos,len,data);
+            reply.setLength(posOfLength + sizeof(numRead) + numRead);
+            reply.writeEndianDirect(posOfLength,sizeof(numRead),&numRead);
+            totalRead += numRead;
+        }
+        stats.addRead(totalRead);
+        if (TF_TRACE)
+            PROGLOG("read multiple, handle = %d, ranges = %u, read = %" I64F "u",handle,num,totalRead);
+    }
+
     void cmdSize(MemoryBuffer & msg, MemoryBuffer & reply)
     {
         int handle;
@@ -5342,6 +5427,7 @@ public:
             case RFCcloseIO:
             case RFCopenIO:
             case RFCread:
+            case RFCreadmulti:
             case RFCsize:
             case RFCwrite:
             case RFCexists:
@@ -5426,6 +5512,7 @@ public:
             switch (cmd)
             {
                 MAPCOMMANDSTATS(RFCread, cmdRead, *stats);
+                MAPCOMMANDSTATS(RFCreadmulti, cmdReadMulti, *stats);
                 MAPCOMMANDSTATS(RFCwrite, cmdWrite, *stats);
                 MAPCOMMANDCLIENTSTATS(RFCappend, cmdAppend, *client, *stats);
                 MAPCOMMAND(RFCcloseIO, cmdCloseFileIO);
@@ -6078,6 +6165,7 @@ class RemoteFileSlowTest : public CppUnit::TestFixture
         CPPUNIT_TEST(testRemoteFilename);
         CPPUNIT_TEST(testStartServer);
         CPPUNIT_TEST(testBasicFunctionality);
+        CPPUNIT_TEST(testReadRanges);
         CPPUNIT_TEST(testCopy);
         CPPUNIT_TEST(testOther);
         CPPUNIT_TEST(testConfiguration);
@@ -6230,6 +6318,62 @@ protected:
         crc.tally(testLen, buf);
         CPPUNIT_ASSERT(writeCrc == crc.get());
     }
+    void testReadRanges()
+    {
+        // The server must be new enough for the client to use RFCreadmulti rather than reading each range in turn
+        SocketEndpoint ep(serverPort);
+        CPPUNIT_ASSERT(getCachedRemoteVersion(ep, false) >= DAFILESRV_READMULTI_MINVERSION);
+
+        VStringBuffer filePath("%s%s", basePath.str(), "file1ranges");
+        Owned<IFile> iFile = createIFile(filePath);
+        const size32_t fileLen = 0x100000;
+        MemoryBuffer mb;
+        byte *buf = (byte *)mb.reserveTruncate(fileLen);
+        for (unsigned b=0; b<fileLen; b++)
+            buf[b] = getRandom()%256;
+        Owned<IFileIO> iFileIO = iFile->open(IFOcreate);
+        CPPUNIT_ASSERT(iFileIO->write(0, fileLen, buf) == fileLen);
+        iFileIO.clear();
+
+        // read several ranges in one request, the first two are adjacent and coalesced, the last is past eof
+        iFileIO.setown(iFile->open(IFOread));
+        CPPUNIT_ASSERT(iFileIO);
+        MemoryBuffer rangeMb;
+        byte *rangeBuf = (byte *)rangeMb.reserveTruncate(400);
+        RemoteReadRange ranges[4];
+        ranges[0].pos = 10; ranges[0].len = 100; ranges[0].data = rangeBuf;
+        ranges[1].pos = 110; ranges[1].len = 50; ranges[1].data = rangeBuf+100;
+        ranges[2].pos = 500; ranges[2].len = 200; ranges[2].data = rangeBuf+150;
+        ranges[3].pos = fileLen-20; ranges[3].len = 50; ranges[3].data = rangeBuf+350;
+        readFileRanges(iFileIO, 4, ranges);
+        CPPUNIT_ASSERT(ranges[0].got == 100 && ranges[1].got == 50 && ranges[2].got == 200 && ranges[3].got == 20);
+        CPPUNIT_ASSERT(0 == memcmp(rangeBuf, buf+10, 150));
+        CPPUNIT_ASSERT(0 == memcmp(rangeBuf+150, buf+500, 200));
+        CPPUNIT_ASSERT(0 == memcmp(rangeBuf+350, buf+fileLen-20, 20));
+        // The coalesced ranges were read as one range - reading them one at a time would have been 4 reads
+        CPPUNIT_ASSERT_EQUAL((unsigned __int64)3, iFileIO->getStatistic(StNumDiskReads));
+
+        // more ranges than can be sent in a single request, in a random order
+        const unsigned numRanges = 3000;
+        const size32_t rangeLen = 64;
+        std::vector<RemoteReadRange> manyRanges(numRanges);
+        MemoryBuffer manyMb;
+        byte *manyBuf = (byte *)manyMb.reserveTruncate(numRanges * rangeLen);
+        for (unsigned i=0; i<numRanges; i++)
+        {
+            manyRanges[i].pos = (getRandom() % (fileLen / rangeLen)) * rangeLen;
+            manyRanges[i].len = rangeLen;
+            manyRanges[i].data = manyBuf + i * rangeLen;
+        }
+        readFileRanges(iFileIO, numRanges, manyRanges.data());
+        iFileIO.clear();
+        for (unsigned i=0; i<numRanges; i++)
+        {
+            CPPUNIT_ASSERT_EQUAL(rangeLen, manyRanges[i].got);
+            CPPUNIT_ASSERT(0 == memcmp(manyRanges[i].data, buf+manyRanges[i].pos, rangeLen));
+        }
+        CPPUNIT_ASSERT(iFile->remove());
+    }
     void testCopy()
     {
         VStringBuffer filePath("%s%s", basePath.str(), "file1");
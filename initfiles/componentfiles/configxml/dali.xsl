@@ -153,7 +153,7 @@
       <xsl:element name="sds">
         <xsl:attribute name="store">dalisds.xml</xsl:attribute>
         <xsl:attribute name="caseInsensitive">0</xsl:attribute>
-        <xsl:copy-of select="@asyncBackup | @deltaSaveThresholdSecs | @deltaTransactionMaxMemMB | @deltaTransactionQueueLimit |
+        <xsl:copy-of select="@asyncBackup | @deltaSaveThresholdSecs | @deltaSync | @deltaTransactionMaxMemMB | @deltaTransactionQueueLimit |
                              @externalSizeThreshold | @enableSNMP | @enableSysLog | @keepStores | @leakStore | @lightweightCoalesce |
                              @msgLevel | @nobackup | @recoverFromIncErrors | @saveBinary | @saveAsync | @snmpSendWarnings | @snmpErrorMsgLevel | @useNFSBackupMount"/>
         <xsl:if test="string(@IdlePeriod) != ''">
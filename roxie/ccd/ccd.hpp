@@ -432,6 +432,7 @@ extern unsigned defaultKeyedJoinPreload;
 extern unsigned defaultPrefetchProjectPreload;
 extern unsigned defaultStrandBlockSize;
 extern unsigned defaultForceNumStrands;
+extern unsigned defaultAutoStrandCostNs;
 extern unsigned defaultHeapFlags;
 
 extern bool defaultCheckingHeap;
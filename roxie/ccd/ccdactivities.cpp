@@ -43,6 +43,7 @@
 #include "thorxmlread.hpp"
 #include "thorcommon.ipp"
 #include "thorstrand.hpp"
+#include "rmtfile.hpp"
 #include "jstats.h"
 
 using roxiemem::OwnedRoxieRow;
@@ -2694,7 +2695,11 @@ public:
         if (createSegmentMonitorsPending)
         {
             createSegmentMonitorsPending = false;
-            tlk->setLayoutTranslator(translators->queryTranslator(lastPartNo.fileNo));
+            const IDynamicTransform * translator = translators->queryTranslator(lastPartNo.fileNo);
+            tlk->setLayoutTranslator(translator);
+            //A translated row only uses the projected fields, so the other payload columns do not need to be expanded
+            IOutputMetaData * projected = translator ? indexHelper->queryProjectedDiskRecordSize() : nullptr;
+            tlk->setPayloadProjection(projected ? &projected->queryRecordAccessor(true) : nullptr);
             indexHelper->createSegmentMonitors(tlk);
             tlk->finishSegmentMonitors();
         }
@@ -3719,6 +3724,21 @@ protected:
 
     virtual size32_t doFetch(ARowBuilder & rowBuilder, offset_t pos, offset_t rawpos, void *inputData) = 0;
 
+    inline offset_t getFetchOffset(offset_t rp) const
+    {
+        if (isLocalFpos(rp))
+            return getLocalFposOffset(rp);
+        else
+            return rp-base;
+    }
+    inline const char *skipRequest(const char *request) const
+    {
+        request += sizeof(PartNoType) + sizeof(offset_t);
+        if (needsRHS)
+            request += sizeof(unsigned) + *(const unsigned *)request;
+        return request;
+    }
+
 public:
     CRoxieFetchActivityBase(AgentContextLogger &_logctx, IRoxieQueryPacket *_packet,  HelperFactory *_hFactory,
                             const CRoxieFetchActivityFactory *_aFactory,
@@ -3779,11 +3799,7 @@ IMessagePacker *CRoxieFetchActivityBase::process()
         }
         else
             rhsSize = 0;
-        offset_t pos;
-        if (isLocalFpos(rp))
-            pos = getLocalFposOffset(rp);
-        else
-            pos = rp-base;
+        offset_t pos = getFetchOffset(rp);
 
         unsigned thisSize = doFetch(rowBuilder, pos, rp, inputData);
         inputData += rhsSize;
@@ -3821,6 +3837,61 @@ class CRoxieFetchActivity : public CRoxieFetchActivityBase
     CThorContiguousRowBuffer prefetchSource;
     Owned<ISourceRowPrefetcher> rowPrefetcher;
 
+    // Fixed size rows are read in batches, so that all the rows fetched from a remote part are read with one request
+    // to dafilesrv per batch, rather than one request per row.
+    static constexpr unsigned maxFetchBatchRows = 1024;
+    static constexpr size32_t maxFetchBatchSize = 0x100000;
+    size32_t fixedDiskSize = 0;
+    std::vector<RemoteReadRange> batch;
+    MemoryAttr batchRows;
+    unsigned batchNext = 0;
+    const char *batchResume = nullptr;     // the first request for the current part that has not been batched
+
+    void fillBatch()
+    {
+        batch.clear();
+        batchNext = 0;
+        unsigned maxRows = std::max(std::min(maxFetchBatchSize / fixedDiskSize, maxFetchBatchRows), 1U);
+        const char *request = batchResume;
+        while (request < inputLimit)
+        {
+            const PartNoType &partNo = *(const PartNoType *) request;
+            if (partNo.partNo != lastPartNo.partNo || partNo.fileNo != lastPartNo.fileNo)
+                break;
+            if (batch.size() == maxRows)
+                break;
+            RemoteReadRange range;
+            range.pos = getFetchOffset(*(const offset_t *)(request + sizeof(PartNoType)));
+            range.len = fixedDiskSize;
+            batch.push_back(range);
+            request = skipRequest(request);
+        }
+        batchResume = request;
+
+        byte *rows = (byte *) batchRows.allocate(batch.size() * fixedDiskSize);
+        for (RemoteReadRange &range : batch)
+        {
+            range.data = rows;
+            rows += fixedDiskSize;
+        }
+        ILazyFileIO *lazyFile = dynamic_cast<ILazyFileIO *>(rawFile.get());
+        if (lazyFile)
+            lazyFile->readRanges(batch.size(), batch.data());
+        else
+            readFileRanges(rawFile, batch.size(), batch.data());
+    }
+
+    const byte *queryBatchedRow(offset_t pos)
+    {
+        if (batchNext == batch.size())
+            fillBatch();
+        const RemoteReadRange &range = batch[batchNext++];
+        assertex(range.pos == pos);
+        if (range.got != fixedDiskSize)
+            throw MakeStringException(ROXIE_FILE_ERROR, "Fetch: failed to read row at offset %" I64F "u of %s", pos, rawFile->queryFile() ? rawFile->queryFile()->queryFilename() : "");
+        return (const byte *) range.data;
+    }
+
 public:
     CRoxieFetchActivity(AgentContextLogger &_logctx, IRoxieQueryPacket *_packet, HelperFactory *_hFactory,
                         const CRoxieFetchActivityFactory *_aFactory,
@@ -3833,13 +3904,22 @@ public:
 
         IOutputMetaData *diskMeta = helper->queryProjectedDiskRecordSize();
         diskAllocator.setown(getRowAllocator(diskMeta, basefactory->queryId()));
+        IOutputMetaData *actualMeta = translators->queryActualLayout(0);
+        if (actualMeta && actualMeta->isFixedSize())
+            fixedDiskSize = actualMeta->getFixedSize();
     }
 
     virtual size32_t doFetch(ARowBuilder & rowBuilder, offset_t pos, offset_t rawpos, void *inputData)
     {
-        prefetchSource.reset(pos);
-        rowPrefetcher->readAhead(prefetchSource);
-        const byte *diskRow = prefetchSource.queryRow();
+        const byte *diskRow;
+        if (fixedDiskSize)
+            diskRow = queryBatchedRow(pos);
+        else
+        {
+            prefetchSource.reset(pos);
+            rowPrefetcher->readAhead(prefetchSource);
+            diskRow = prefetchSource.queryRow();
+        }
         if (translator)
         {
             MemoryBuffer buf;
@@ -3862,6 +3942,10 @@ public:
     {
         CRoxieFetchActivityBase::setPartNo(filechanged);
         prefetchSource.setStream(rawStream);
+        // Called before the first request for the new part is processed
+        batch.clear();
+        batchNext = 0;
+        batchResume = inputData;
     }
 };
 
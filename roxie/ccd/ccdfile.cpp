@@ -46,6 +46,11 @@
 #include "thorcommon.hpp"
 #include "eclhelper_dyn.hpp"
 #include "rtldynfield.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 std::atomic<unsigned> numFilesOpen[2];
 std::atomic<unsigned> filesReopened = 0;
@@ -411,6 +416,50 @@ public:
         }
     }
 
+    virtual void readRanges(unsigned num, RemoteReadRange *ranges) override
+    {
+        unsigned activeIdx;
+        Owned<IFileIO> active = getCheckOpen(activeIdx);
+        unsigned tries = 0;
+        for (;;)
+        {
+            try
+            {
+                readFileRanges(active, num, ranges);
+                lastAccess = nsTick();
+                if (cached && !remote)
+                {
+                    for (unsigned i = 0; i < num; i++)
+                        cached->noteRead(fileIdx, ranges[i].pos, ranges[i].got);
+                }
+                return;
+            }
+            catch (NotYetOpenException *E)
+            {
+                E->Release();
+            }
+            catch (IException *E)
+            {
+                StringBuffer msg;
+                E->errorMessage(msg);
+                E->Release();
+                OERRLOG("Failed to read %u ranges of file %s [%s]", num, sources.item(activeIdx).queryFilename(), msg.str());
+                {
+                    CriticalBlock b(crit);
+                    if (currentIdx == activeIdx)
+                    {
+                        currentIdx = activeIdx+1;
+                        setFailure();
+                    }
+                }
+            }
+            active.setown(getCheckOpen(activeIdx));
+            tries++;
+            if (tries == MAX_READ_RETRIES)
+                throw MakeStringException(ROXIE_FILE_ERROR, "Failed to read %u ranges of file %s after %d attempts", num, sources.item(activeIdx).queryFilename(), tries);
+        }
+    }
+
     virtual void flush()
     {
         Linked<IFileIO> active;
@@ -828,9 +877,34 @@ private:
     }
 };
 
+// Limits the rate at which index pages are prewarmed, shared by all the threads warming the cache
+
+class CacheWarmingThrottle
+{
+    unsigned pagesPerSecond;
+    unsigned startTime;
+    std::atomic<unsigned __int64> pagesWarmed{0};
+public:
+    CacheWarmingThrottle(unsigned _pagesPerSecond) : pagesPerSecond(_pagesPerSecond), startTime(msTick()) {}
+
+    void notePage()
+    {
+        if (!pagesPerSecond)
+            return;
+        unsigned __int64 n = ++pagesWarmed;
+        unsigned __int64 due = (n * 1000) / pagesPerSecond;
+        unsigned elapsed = msTick() - startTime;
+        if (due > elapsed)
+            MilliSleep((unsigned) (due - elapsed));
+    }
+};
+
 class IndexCacheWarmer : implements ICacheWarmer
 {
     IRoxieFileCache *cache = nullptr;
+    CacheWarmingThrottle *throttle = nullptr;
+    const std::atomic<bool> *aborting = nullptr;
+    std::atomic<unsigned> *totalPagesPreloaded = nullptr;
     Owned<ILazyFileIO> localFile;
     Owned<IKeyIndex> keyIndex;
     Owned<IKeyIndexPrewarmer> prewarmer;
@@ -839,7 +913,10 @@ class IndexCacheWarmer : implements ICacheWarmer
     unsigned filesProcessed = 0;
     unsigned pagesPreloaded = 0;
 public:
-    IndexCacheWarmer(IRoxieFileCache *_cache) : cache(_cache) {}
+    IndexCacheWarmer(IRoxieFileCache *_cache, CacheWarmingThrottle *_throttle, const std::atomic<bool> *_aborting, std::atomic<unsigned> *_totalPagesPreloaded)
+    : cache(_cache), throttle(_throttle), aborting(_aborting), totalPagesPreloaded(_totalPagesPreloaded)
+    {
+    }
 
     virtual void startFile(const char *filename) override
     {
@@ -872,12 +949,18 @@ public:
             startOffset = ((startOffset+nodeSize-1)/nodeSize)*nodeSize;
             do
             {
+                if (aborting && *aborting)
+                    return false;
+                if (throttle)
+                    throttle->notePage();
                 if (doTrace(traceRoxiePrewarm))
                     DBGLOG("prewarming index page %u %s %" I64F "x-%" I64F "x", (int) nodeType, filename, startOffset, endOffset);
                 bool loaded = prewarmer->prewarmPage(startOffset, nodeType);
                 if (!loaded)
                     break;
                 pagesPreloaded++;
+                if (totalPagesPreloaded)
+                    (*totalPagesPreloaded)++;
                 startOffset += nodeSize;
             }
             while (startOffset < endOffset);
@@ -900,6 +983,157 @@ public:
     }
 };
 
+// Collects the pages listed in one or more sets of cacheInfo, so that they can be warmed in priority order by a pool
+// of threads rather than in the order they were recorded. The cacheInfo does not record how often a page was used,
+// so pages are prioritized by the kind of node they hold - branch nodes are needed by every lookup, then leaves,
+// then blobs, and finally the pages that were only in the OS cache.
+
+class CacheWarmingPlan : implements ICacheWarmer
+{
+public:
+    static constexpr unsigned numPriorities = 4;
+
+    struct Block
+    {
+        NodeType nodeType;
+        offset_t startOffset;
+        offset_t endOffset;
+    };
+
+    struct FileBlocks
+    {
+        StringAttr filename;
+        std::vector<Block> blocks[numPriorities];
+    };
+
+    virtual void startFile(const char *filename) override
+    {
+        auto match = fileMap.find(filename);
+        if (match == fileMap.end())
+        {
+            match = fileMap.emplace(filename, files.size()).first;
+            files.emplace_back();
+            files.back().filename.set(filename);
+        }
+        curFile = match->second;
+    }
+
+    virtual bool warmBlock(const char *filename, NodeType nodeType, offset_t startOffset, offset_t endOffset) override
+    {
+        files[curFile].blocks[getPriority(nodeType)].push_back({nodeType, startOffset, endOffset});
+        return true;
+    }
+
+    virtual void endFile() override
+    {
+    }
+
+    virtual void report() override
+    {
+    }
+
+    void warm(IRoxieFileCache *cache, unsigned numThreads, unsigned pagesPerSecond, const std::atomic<bool> *aborting)
+    {
+        CacheWarmingThrottle throttle(pagesPerSecond);
+        std::atomic<unsigned> pagesPreloaded{0};
+        unsigned start = msTick();
+        // Files that are kept open between the passes count towards the local files roxie keeps open
+        warmBlocks<IndexCacheWarmer>(numThreads, minFilesOpen[false], aborting, [&]()
+        {
+            return new IndexCacheWarmer(cache, &throttle, aborting, &pagesPreloaded);
+        });
+        if (traceLevel)
+            DBGLOG("Processed %u files and preloaded %u index nodes using %u threads in %u ms", (unsigned) files.size(), pagesPreloaded.load(), numThreads, msTick() - start);
+    }
+
+    // Pass the blocks of all the files to warmers created by createWarmer - the branch nodes of every file first, then
+    // the leaves, and so on.  A file's warmer is started before the first pass that has blocks for it, and ended after
+    // the last one, so that most files are only opened once.  At most maxOpenFiles warmers are kept open between
+    // passes - any others are ended, and started again by the next pass that needs them.  The passes are sequential,
+    // so a warmer is only used by one thread at a time.
+    template <class WARMER>
+    void warmBlocks(unsigned numThreads, unsigned maxOpenFiles, const std::atomic<bool> *aborting, const std::function<WARMER *()> &createWarmer)
+    {
+        std::vector<unsigned> lastPriority(files.size(), 0);
+        for (unsigned idx = 0; idx < files.size(); idx++)
+        {
+            for (unsigned priority = 0; priority < numPriorities; priority++)
+            {
+                if (!files[idx].blocks[priority].empty())
+                    lastPriority[idx] = priority;
+            }
+        }
+
+        std::vector<std::unique_ptr<WARMER>> warmers(files.size());
+        for (unsigned priority = 0; priority < numPriorities; priority++)
+        {
+            std::vector<unsigned> todo;
+            for (unsigned idx = 0; idx < files.size(); idx++)
+            {
+                if (!files[idx].blocks[priority].empty())
+                    todo.push_back(idx);
+            }
+            asyncFor(todo.size(), numThreads, [&](unsigned i)
+            {
+                unsigned idx = todo[i];
+                FileBlocks &file = files[idx];
+                std::unique_ptr<WARMER> &warmer = warmers[idx];
+                if (!warmer)
+                {
+                    warmer.reset(createWarmer());
+                    warmer->startFile(file.filename);
+                }
+                for (const Block &block : file.blocks[priority])
+                {
+                    if (!warmer->warmBlock(file.filename, block.nodeType, block.startOffset, block.endOffset))
+                        break;
+                }
+                if (priority == lastPriority[idx])
+                {
+                    warmer->endFile();
+                    warmer.reset();
+                }
+            });
+
+            unsigned numOpen = 0;
+            for (std::unique_ptr<WARMER> &warmer : warmers)
+            {
+                if (warmer && (++numOpen > maxOpenFiles))
+                {
+                    warmer->endFile();
+                    warmer.reset();
+                }
+            }
+            if (aborting && *aborting)
+                break;
+        }
+
+        // Only files whose later passes were abandoned are still open
+        for (std::unique_ptr<WARMER> &warmer : warmers)
+        {
+            if (warmer)
+                warmer->endFile();
+        }
+    }
+
+protected:
+    static unsigned getPriority(NodeType nodeType)
+    {
+        switch (nodeType)
+        {
+        case NodeBranch: return 0;
+        case NodeLeaf: return 1;
+        case NodeBlob: return 2;
+        default: return 3;
+        }
+    }
+
+protected:
+    std::vector<FileBlocks> files;
+    std::unordered_map<std::string, unsigned> fileMap;
+    unsigned curFile = 0;
+};
+
 static bool getDirectAccessStoragePlanes(StringArray &planes)
 {
     Owned<IPropertyTreeIterator> iter = getComponentConfigSP()->getElements("directAccessPlanes");
@@ -930,6 +1164,8 @@ class CRoxieFileCache : implements IRoxieFileCache, implements ICopyFileProgress
     std::atomic<bool> closePending[2];
     StringAttrMapping fileErrorList;
     bool cidtActive = false;
+    bool cwtActive = false;
+    std::atomic<bool> prewarming{false};
     Semaphore cidtStarted;
     Semaphore bctStarted;
     Semaphore hctStarted;
@@ -1011,6 +1247,9 @@ class CRoxieFileCache : implements IRoxieFileCache, implements ICopyFileProgress
                 cidtSleep.wait(cacheReportPeriodSeconds * 1000);
                 if (closing)
                     break;
+                // Don't overwrite the saved cache info with a partial picture while it is still being used to warm the caches
+                if (prewarming)
+                    continue;
                 if (doTrace(traceRoxieFiles, TraceFlags::Max))
                     DBGLOG("Cache info dump");
 
@@ -1400,7 +1639,7 @@ public:
     IMPLEMENT_IINTERFACE;
 
     CRoxieFileCache() :
-                        cidt(*this),
+                        cidt(*this), cwt(*this),
                         bct(*this), hct(*this)
     {
         aborting = false;
@@ -1518,6 +1757,37 @@ public:
         }
     } cidt;
 
+    class CacheWarmingThread : public Thread
+    {
+        CRoxieFileCache &owner;
+    public:
+        CacheWarmingThread(CRoxieFileCache &_owner) : Thread("CRoxieFileCache-CacheWarmingThread"), owner(_owner) {}
+
+        virtual int run()
+        {
+            return owner.runCacheWarming();
+        }
+    } cwt;
+
+    int runCacheWarming()
+    {
+        if (traceLevel)
+            DBGLOG("Cache warming thread %p starting", this);
+        try
+        {
+            doLoadSavedOsCacheInfo();
+        }
+        catch (IException *E)
+        {
+            EXCLOG(E);
+            E->Release();
+        }
+        prewarming = false;
+        if (traceLevel)
+            DBGLOG("Cache warming thread %p exiting", this);
+        return 0;
+    }
+
     class BackgroundCopyThread : public Thread
     {
         CRoxieFileCache &owner;
@@ -1748,6 +2018,8 @@ public:
             cidt.join(timeout);
         }
 #endif
+        if (cwtActive)
+            cwt.join(timeout);
     }
 
     virtual void wait()
@@ -1767,6 +2039,8 @@ public:
             cidt.join();
         }
 #endif
+        if (cwtActive)
+            cwt.join();
     }
 
     virtual CFPmode onProgress(unsigned __int64 sizeDone, unsigned __int64 totalSize)
@@ -2103,13 +2377,40 @@ public:
     {
         if (!topology->getPropBool("@warmOsCache", true))
             return;
+        if (topology->getPropBool("@backgroundCachePrewarming", false))
+        {
+            // Queries can be served (more slowly) while the caches are warmed
+            prewarming = true;
+            cwt.start(false);
+            cwtActive = true;
+        }
+        else
+            doLoadSavedOsCacheInfo();
+    }
+
+    void warmCaches(CacheWarmingPlan &plan)
+    {
+        unsigned numThreads = topology->getPropInt("@cachePrewarmThreads", 1);
+        unsigned pagesPerSecond = topology->getPropInt("@cachePrewarmPagesPerSecond", 0);
+        plan.warm(this, numThreads ? numThreads : 1, pagesPerSecond, &closing);
+    }
+
+    void doLoadSavedOsCacheInfo()
+    {
+        // Collect the pages for all channels first so that the most valuable pages of every channel are warmed first
+        CacheWarmingPlan plan;
         Owned<const ITopologyServer> topology = getTopology();
         for (unsigned channel : topology->queryChannels())
-            doLoadSavedOsCacheInfo(channel);
-        doLoadSavedOsCacheInfo(0);  // MORE - maybe only if I am also a server?
+        {
+            if (closing)
+                return;
+            doLoadSavedOsCacheInfo(channel, plan);
+        }
+        doLoadSavedOsCacheInfo(0, plan);  // MORE - maybe only if I am also a server?
+        warmCaches(plan);
     }
 
-    void doLoadSavedOsCacheInfo(unsigned channel)
+    void doLoadSavedOsCacheInfo(unsigned channel, CacheWarmingPlan &plan)
     {
         StringBuffer cacheRootDirectory;
         if (isContainerized())
@@ -2153,7 +2454,8 @@ public:
                 cacheInfo.loadFile(cacheFileName, false);
                 if (traceLevel)
                     DBGLOG("Loading cache information from %s for channel %d", cacheFileName.str(), channel);
-                warmOsCache(cacheInfo);
+                if (!::warmOsCache(cacheInfo, &plan))
+                    DBGLOG("WARNING: Unrecognized cacheInfo format in %s", cacheFileName.str());
             }
         }
         catch(IException *E)
@@ -2168,10 +2470,10 @@ public:
     {
         if (!cacheInfo)
             return;
-        IndexCacheWarmer warmer(this);
-        if (!::warmOsCache(cacheInfo, &warmer))
+        CacheWarmingPlan plan;
+        if (!::warmOsCache(cacheInfo, &plan))
             DBGLOG("WARNING: Unrecognized cacheInfo format");
-        warmer.report();
+        warmCaches(plan);
     }
 
     virtual void clearOsCache() override
@@ -4084,3 +4386,129 @@ CPPUNIT_TEST_SUITE_REGISTRATION( CcdFileTest );
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( CcdFileTest, "CcdFileTest" );
 #endif
 #endif
+
+#ifdef _USE_CPPUNIT
+#include "unittests.hpp"
+
+class CacheWarmingTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(CacheWarmingTest);
+        CPPUNIT_TEST(testPlanOrder);
+        CPPUNIT_TEST(testThrottle);
+    CPPUNIT_TEST_SUITE_END();
+protected:
+
+    // Records the calls made to every warmer, in the order that they are made
+    class RecordingWarmer : implements ICacheWarmer
+    {
+        StringArray &events;
+        StringAttr curFile;
+    public:
+        RecordingWarmer(StringArray &_events) : events(_events) {}
+
+        virtual void startFile(const char *filename) override
+        {
+            curFile.set(filename);
+            events.append(VStringBuffer("start %s", filename));
+        }
+        virtual bool warmBlock(const char *filename, NodeType nodeType, offset_t startOffset, offset_t endOffset) override
+        {
+            CPPUNIT_ASSERT_EQUAL(std::string(curFile.str()), std::string(filename));
+            events.append(VStringBuffer("%s %u %" I64F "x", filename, (unsigned) nodeType, startOffset));
+            return true;
+        }
+        virtual void endFile() override
+        {
+            events.append(VStringBuffer("end %s", curFile.str()));
+        }
+        virtual void report() override
+        {
+        }
+    };
+
+    void checkEvents(const StringArray &events, const char * const *expected, unsigned numExpected)
+    {
+        CPPUNIT_ASSERT_EQUAL(numExpected, events.ordinality());
+        for (unsigned i = 0; i < numExpected; i++)
+            CPPUNIT_ASSERT_EQUAL(std::string(expected[i]), std::string(events.item(i)));
+    }
+
+    void testPlanOrder()
+    {
+        CacheWarmingPlan plan;
+        plan.startFile("a");
+        plan.warmBlock("a", NodeLeaf, 0x2000, 0x3000);
+        plan.warmBlock("a", NodeBranch, 0x1000, 0x2000);
+        plan.endFile();
+        plan.startFile("b");
+        plan.warmBlock("b", NodeNone, 0x4000, 0x5000);
+        plan.warmBlock("b", NodeBranch, 0x6000, 0x7000);
+        plan.endFile();
+        // A second set of cacheInfo for the same file is merged with the first
+        plan.startFile("a");
+        plan.warmBlock("a", NodeBlob, 0x8000, 0x9000);
+        plan.endFile();
+
+        // Each file is opened once, all the branches are warmed before any leaves, blobs or other pages, and each
+        // file is closed once its last page has been warmed.
+        StringArray events;
+        plan.warmBlocks<RecordingWarmer>(1, 100, nullptr, [&]() { return new RecordingWarmer(events); });
+        const char * const expected[] = {
+            "start a", "a 0 1000",
+            "start b", "b 0 6000",
+            "a 1 2000",
+            "a 2 8000", "end a",
+            "b 127 4000", "end b"
+        };
+        checkEvents(events, expected, sizeof(expected)/sizeof(expected[0]));
+
+        // If only one file can be kept open between passes, b is closed after the branches and reopened for its last
+        // pass
+        events.kill();
+        plan.warmBlocks<RecordingWarmer>(1, 1, nullptr, [&]() { return new RecordingWarmer(events); });
+        const char * const expectedLimited[] = {
+            "start a", "a 0 1000",
+            "start b", "b 0 6000", "end b",
+            "a 1 2000",
+            "a 2 8000", "end a",
+            "start b", "b 127 4000", "end b"
+        };
+        checkEvents(events, expectedLimited, sizeof(expectedLimited)/sizeof(expectedLimited[0]));
+
+        // Warming is abandoned between passes once aborting is set, but the open files are still closed
+        std::atomic<bool> aborting{true};
+        events.kill();
+        plan.warmBlocks<RecordingWarmer>(1, 100, &aborting, [&]() { return new RecordingWarmer(events); });
+        const char * const expectedAbort[] = {
+            "start a", "a 0 1000",
+            "start b", "b 0 6000",
+            "end a", "end b"
+        };
+        checkEvents(events, expectedAbort, sizeof(expectedAbort)/sizeof(expectedAbort[0]));
+    }
+
+    void testThrottle()
+    {
+        // No limit - the pages are not delayed
+        CacheWarmingThrottle unlimited(0);
+        unsigned start = msTick();
+        for (unsigned i = 0; i < 1000; i++)
+            unlimited.notePage();
+        CPPUNIT_ASSERT(msTick() - start < 100);
+
+        // 200 pages a second - each page is numbered by a single increment, so the 20th page cannot be warmed until
+        // 100ms after the throttle was created, whichever thread warms it
+        start = msTick();
+        CacheWarmingThrottle throttle(200);
+        asyncFor(4, 4, [&](unsigned i)
+        {
+            for (unsigned page = 0; page < 5; page++)
+                throttle.notePage();
+        });
+        CPPUNIT_ASSERT(msTick() - start >= 100);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( CacheWarmingTest );
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( CacheWarmingTest, "CacheWarmingTest" );
+#endif
@@ -27,6 +27,7 @@ enum RoxieFileStatus { FileSizeMismatch, FileDateMismatch, FileCRCMismatch, File
 enum RoxieFileType { ROXIE_KEY, ROXIE_FILE, ROXIE_PATCH, ROXIE_BASEINDEX };
 interface IFileIOArray;
 interface IRoxieFileCache;
+struct RemoteReadRange;
 
 interface ILazyFileIO : extends IFileIO
 {
@@ -54,6 +55,7 @@ interface ILazyFileIO : extends IFileIO
     virtual void removeCache(const IRoxieFileCache *) = 0;
     virtual unsigned getFileIdx() const = 0;
     virtual unsigned getCrc() const = 0;
+    virtual void readRanges(unsigned num, RemoteReadRange *ranges) = 0;    // read several ranges, with a single request if remote
     virtual bool checkCopyComplete() = 0;
     virtual void dump() const = 0;
 };
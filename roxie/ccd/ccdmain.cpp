@@ -181,6 +181,7 @@ bool defaultCheckingHeap = false;
 bool defaultDisableLocalOptimizations = false;
 unsigned defaultStrandBlockSize = 512;
 unsigned defaultForceNumStrands = 0;
+unsigned defaultAutoStrandCostNs = 0;
 unsigned defaultHeapFlags = roxiemem::RHFnone;
 
 unsigned agentQueryReleaseDelaySeconds = 60;
@@ -1083,6 +1084,9 @@ int CCD_API roxie_main(int argc, const char *argv[], const char * defaultYaml)
         doIbytiDelay = topology->getPropBool("@doIbytiDelay", true);
         minIbytiDelay = topology->getPropInt("@minIbytiDelay", 2);
         initIbytiDelay = topology->getPropInt("@initIbytiDelay", 50);
+        ibytiDelayPercentile = topology->getPropInt("@ibytiDelayPercentile", 0);
+        if (ibytiDelayPercentile > 100)
+            ibytiDelayPercentile = 100;
         alwaysTrustFormatCrcs = topology->getPropBool("@alwaysTrustFormatCrcs", true);
         allFilesDynamic = topology->getPropBool("@allFilesDynamic", false);
         lockSuperFiles = topology->getPropBool("@lockSuperFiles", false);
@@ -1124,6 +1128,7 @@ int CCD_API roxie_main(int argc, const char *argv[], const char * defaultYaml)
         traceStrands = topology->getPropBool("@traceStrands", false);
 
         useMemoryMappedIndexes = topology->getPropBool("@useMemoryMappedIndexes", false);
+        residentIndexMaxSize = topology->getPropInt64("@residentIndexMaxSize", 0);
         flushJHtreeCacheOnOOM = topology->getPropBool("@flushJHtreeCacheOnOOM", true);
         fastLaneQueue = topology->getPropBool("@fastLaneQueue", true);
         udpOutQsPriority = topology->getPropInt("@udpOutQsPriority", 0);
@@ -1231,6 +1236,7 @@ int CCD_API roxie_main(int argc, const char *argv[], const char * defaultYaml)
         defaultPrefetchProjectPreload = topology->getPropInt("@defaultPrefetchProjectPreload", 10);
         defaultStrandBlockSize = topology->getPropInt("@defaultStrandBlockSize", 512);
         defaultForceNumStrands = topology->getPropInt("@defaultForceNumStrands", 0);
+        defaultAutoStrandCostNs = topology->getPropInt("@defaultAutoStrandCostNs", 0);
         defaultCheckingHeap = topology->getPropBool("@checkingHeap", false);  // NOTE - not in configmgr - too dangerous!
         defaultDisableLocalOptimizations = topology->getPropBool("@disableLocalOptimizations", false);  // NOTE - not in configmgr - too dangerous!
 
@@ -335,6 +335,7 @@ QueryOptions::QueryOptions()
     bindCores = coresPerQuery;
     strandBlockSize = defaultStrandBlockSize;
     forceNumStrands = defaultForceNumStrands;
+    autoStrandCostNs = defaultAutoStrandCostNs;
     heapFlags = defaultHeapFlags;
 
     checkingHeap = defaultCheckingHeap;
@@ -376,6 +377,7 @@ QueryOptions::QueryOptions(const QueryOptions &other)
     bindCores = other.bindCores;
     strandBlockSize = other.strandBlockSize;
     forceNumStrands = other.forceNumStrands;
+    autoStrandCostNs = other.autoStrandCostNs;
     heapFlags = other.heapFlags;
 
     checkingHeap = other.checkingHeap;
@@ -446,6 +448,7 @@ void QueryOptions::setFromWorkUnit(IConstWorkUnit &wu, const IPropertyTree *stat
     updateFromWorkUnit(bindCores, wu, "bindCores");
     updateFromWorkUnit(strandBlockSize, wu, "strandBlockSize");
     updateFromWorkUnit(forceNumStrands, wu, "forceNumStrands");
+    updateFromWorkUnit(autoStrandCostNs, wu, "autoStrandCostNs");
     updateFromWorkUnit(heapFlags, wu, "heapFlags");
 
     updateFromWorkUnit(checkingHeap, wu, "checkingHeap");
@@ -538,6 +541,7 @@ void QueryOptions::setFromContext(const IPropertyTree *ctx)
         updateFromContext(bindCores, ctx, "@bindCores", "_bindCores");
         updateFromContext(strandBlockSize, ctx, "@strandBlockSize", "_strandBlockSize");
         updateFromContext(forceNumStrands, ctx, "@forceNumStrands", "_forceNumStrands");
+        updateFromContext(autoStrandCostNs, ctx, "@autoStrandCostNs", "_autoStrandCostNs");
         updateFromContext(heapFlags, ctx, "@heapFlags", "_HeapFlags");
 
         updateFromContext(checkingHeap, ctx, "@checkingHeap", "_CheckingHeap");
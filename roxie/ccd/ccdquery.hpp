@@ -99,6 +99,7 @@ public:
     int bindCores;
     unsigned strandBlockSize;
     unsigned forceNumStrands;
+    unsigned autoStrandCostNs;
     unsigned heapFlags;
 
     bool checkingHeap;
@@ -2200,7 +2200,7 @@ public:
         while (head)
             removeEntry(head);
     }
-    bool doIBYTI(const RoxiePacketHeader &ibyti)
+    bool doIBYTI(const RoxiePacketHeader &ibyti, unsigned *waited = nullptr)
     {
         // RoxieSocketQueueManager::ibytiCrit must be locked while this is executing
 
@@ -2214,6 +2214,8 @@ public:
                     StringBuffer s;
                     DBGLOG("IBYTI removing delayed packet %s", finger->describe(s).str());
                 }
+                if (waited)
+                    *waited = (unsigned) ((nsTick() - finger->packet->queryEnqueuedTimeStamp()) / 1000000);
                 removeEntry(finger);
                 return true;
             }
@@ -2276,6 +2278,8 @@ public:
                     case ROXIE_LOW_PRIORITY: loQueue.enqueue(packet, IBYTIdelay); break;
                     default: bgQueue.enqueue(packet, IBYTIdelay); break;
                 }
+                if (!header.subChannels[0].isMe() && !header.subChannels[0].isNull())
+                    noteNodeMissed(header.subChannels[0]);  // As for a response, only the primary's wait is independent of the other buddies
                 for (unsigned subChannel = 0; subChannel < MAX_SUBCHANNEL; subChannel++)
                 {
                     if (header.subChannels[subChannel].isMe() || header.subChannels[subChannel].isNull())
@@ -2699,7 +2703,10 @@ public:
         else
         {
             noteNodeHealthy(header.subChannels[subChannel]);
-            bool foundInQ = mySubChannel != 0 && delayed.queryQueue(header.channel, mySubChannel).doIBYTI(header);
+            unsigned waited = 0;
+            bool foundInQ = mySubChannel != 0 && delayed.queryQueue(header.channel, mySubChannel).doIBYTI(header, &waited);
+            if (foundInQ && subChannel == 0)
+                noteNodeResponse(header.subChannels[subChannel], waited);  // Only the primary's response time is independent of the other buddies
             if (!foundInQ)
                 foundInQ = queue.remove(header);  // Check on list waiting for a free worker
             if (foundInQ)
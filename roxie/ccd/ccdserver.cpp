@@ -2129,6 +2129,68 @@ public:
 
 //=================================================================================
 
+// Per-row cost of a stranded activity, accumulated over its first executions.  Shared by all the
+// instances created from the same factory, so later executions can choose a strand count when the
+// query does not specify one.
+class StrandCostProfile : public CInterface
+{
+    static constexpr unsigned __int64 minSampleRows = 1000;
+public:
+    void noteExecution(unsigned __int64 rows, unsigned __int64 cycles)
+    {
+        if (rows && !isSampled())
+        {
+            sampledRows += rows;
+            sampledCycles += cycles;
+        }
+    }
+    inline bool isSampled() const { return sampledRows >= minSampleRows; }
+    unsigned __int64 queryNsPerRow() const
+    {
+        unsigned __int64 rows = sampledRows;
+        return rows ? cycle_to_nanosec(sampledCycles) / rows : 0;
+    }
+private:
+    std::atomic<unsigned __int64> sampledRows{0};
+    std::atomic<unsigned __int64> sampledCycles{0};
+};
+
+// Strands in use by activities that were stranded automatically, used to avoid oversubscribing the cores.
+// Strands are reserved when the number is chosen (as the activity is created) and released when it stops.
+static std::atomic<unsigned> numAutoStrandsActive{0};
+
+// Choose the number of strands for an activity that costs nsPerRow, given the number of strands already
+// reserved by other automatically stranded activities.  A single activity is limited to half of the
+// remaining cores so that activities starting later (possibly in other queries) are not starved.
+// Returns 0 if the activity should not be stranded.
+static unsigned chooseAutoStrands(unsigned __int64 nsPerRow, unsigned costThresholdNs, unsigned maxStrands, unsigned numCpus, unsigned activeStrands)
+{
+    if (!costThresholdNs || (nsPerRow < costThresholdNs))
+        return 0;
+    if (activeStrands >= numCpus)
+        return 0;
+    unsigned share = (numCpus - activeStrands + 1) / 2;
+    unsigned wanted = std::min(std::min(maxStrands, share), (unsigned)MAX_SENSIBLE_STRANDS);
+    return (wanted >= 2) ? wanted : 0;
+}
+
+// Choose the number of strands as chooseAutoStrands does, and reserve them in the same step, so that activities
+// created at the same time each see the strands already taken by the others.
+static unsigned reserveAutoStrands(unsigned __int64 nsPerRow, unsigned costThresholdNs, unsigned maxStrands, unsigned numCpus, std::atomic<unsigned> &activeStrands)
+{
+    unsigned active = activeStrands.load();
+    for (;;)
+    {
+        unsigned wanted = chooseAutoStrands(nsPerRow, costThresholdNs, maxStrands, numCpus, active);
+        if (!wanted)
+            return 0;
+        if (activeStrands.compare_exchange_weak(active, active + wanted))
+            return wanted;
+    }
+}
+
+static std::atomic<bool> warnedAutoStrandsUntimed{false};
+
 class StrandOptions
 {
     // Typically set from hints, common to many stranded activities
@@ -2140,20 +2202,59 @@ public:
         if ((numStrands == minus1U) || (numStrands > MAX_SENSIBLE_STRANDS))
             numStrands = getAffinityCpus();
         blockSize = _graphNode.getPropInt("hint[@name='strandblocksize']/@value", 0);
+        costProfile.setown(new StrandCostProfile);
     }
     StrandOptions(const StrandOptions &from, IRoxieAgentContext *ctx)
     {
         numStrands = from.numStrands;
         blockSize = from.blockSize;
+        costProfile.set(from.costProfile);
 
         if (!blockSize)
             blockSize = ctx->queryOptions().strandBlockSize;
         if (numStrands == 0)
             numStrands = ctx->queryOptions().forceNumStrands;
+        if (numStrands == 0)
+        {
+            unsigned costThresholdNs = ctx->queryOptions().autoStrandCostNs;
+            if (costThresholdNs && !ctx->queryOptions().timeActivities)
+            {
+                // The per-row cost is measured from the activity timings, so nothing is ever profiled
+                if (!warnedAutoStrandsUntimed.exchange(true))
+                    OWARNLOG("autoStrandCostNs=%u has no effect because timeActivities is disabled", costThresholdNs);
+            }
+            else
+            {
+                numStrands = selectAutoStrands(costThresholdNs);
+                autoSelected = (numStrands != 0);
+            }
+        }
+    }
+
+    void noteExecution(unsigned __int64 rows, unsigned __int64 cycles)
+    {
+        if (costProfile)
+            costProfile->noteExecution(rows, cycles);
     }
+
+private:
+    // Once enough rows have been profiled, an activity that costs more than costThresholdNs per row is
+    // given a share of the cores not currently used by other automatically stranded activities.  The
+    // strands are reserved in numAutoStrandsActive, and the activity takes over that reservation.
+    unsigned selectAutoStrands(unsigned costThresholdNs)
+    {
+        if (!costThresholdNs || !costProfile || !costProfile->isSampled())
+            return 0;
+        unsigned maxStrands = coresPerQuery ? coresPerQuery : getAffinityCpus();
+        return reserveAutoStrands(costProfile->queryNsPerRow(), costThresholdNs, maxStrands, getAffinityCpus(), numAutoStrandsActive);
+    }
+
 public:
     unsigned numStrands = 0; // if 1 it forces single-stranded operations.  (Useful for testing.)
     unsigned blockSize = 0;
+    bool autoSelected = false; // numStrands was chosen from the measured cost, and reserved in numAutoStrandsActive
+private:
+    Linked<StrandCostProfile> costProfile;
 };
 
 class StrandProcessor : public CInterfaceOf<IEngineRowStream>
@@ -2233,12 +2334,21 @@ protected:
     Owned<IStrandJunction> splitter;
     Owned<IStrandJunction> sourceJunction; // A junction applied to the output of a source activity
     std::atomic<unsigned> active;
+    unsigned __int64 notedRows = 0;
+    unsigned __int64 notedCycles = 0;
+    unsigned reservedStrands = 0; // strands reserved in numAutoStrandsActive by this activity
 public:
     CRoxieServerStrandedActivity(IRoxieAgentContext *_ctx, const IRoxieServerActivityFactory *_factory, IProbeManager *_probeManager, const StrandOptions &_strandOptions)
         : CRoxieServerActivity(_ctx, _factory, _probeManager),
           strandOptions(_strandOptions, ctx)
     {
         active = 0;
+        if (strandOptions.autoSelected)
+            reservedStrands = strandOptions.numStrands;
+    }
+    ~CRoxieServerStrandedActivity()
+    {
+        releaseAutoStrands();
     }
 
     virtual void gatherStats(CRuntimeStatisticCollection & merged) const override
@@ -2262,6 +2372,9 @@ public:
     virtual void reset()
     {
         assertex(active==0);
+        releaseAutoStrands();
+        if (timeActivities)
+            noteExecutionCost();
         CRoxieServerActivity::reset();
 
         //Stats have already been merged into the stranded activity when the strands were stopped.
@@ -2278,7 +2391,10 @@ public:
         if (active)
             --active;
         if (!active)
+        {
+            releaseAutoStrands();
             CRoxieServerActivity::stop();
+        }
     }
 
     virtual unsigned __int64 queryTotalCycles() const override
@@ -2424,6 +2540,10 @@ protected:
 
     void onStartStrands()
     {
+        // The number reserved when the activity was created may have been overridden by the consumer or the input,
+        // and a later execution (e.g. of a child query) needs to reserve its strands again.
+        if (strandOptions.autoSelected)
+            setReservedStrands((strands.ordinality() > 1) ? strands.ordinality() : 0);
         ForEachItemIn(idx, strands)
         {
             strands.item(idx).start();
@@ -2431,6 +2551,32 @@ protected:
         }
     }
 
+    void setReservedStrands(unsigned numReserved)
+    {
+        if (numReserved > reservedStrands)
+            numAutoStrandsActive += numReserved - reservedStrands;
+        else if (numReserved < reservedStrands)
+            numAutoStrandsActive -= reservedStrands - numReserved;
+        reservedStrands = numReserved;
+    }
+
+    void releaseAutoStrands()
+    {
+        setReservedStrands(0);
+    }
+
+    // The row counts and timings accumulate across executions (e.g. within a child query), so only
+    // the increase since the previous reset is added to the profile.
+    void noteExecutionCost()
+    {
+        unsigned __int64 rows = getTotalRowsProcessed();
+        unsigned __int64 cycles = queryLocalCycles();
+        if ((rows > notedRows) && (cycles >= notedCycles))
+            strandOptions.noteExecution(rows - notedRows, cycles - notedCycles);
+        notedRows = rows;
+        notedCycles = cycles;
+    }
+
     virtual unsigned getTotalRowsProcessed() const override
     {
         unsigned total = 0;
@@ -29246,6 +29392,8 @@ class CcdServerTest : public CppUnit::TestFixture
         CPPUNIT_TEST(testMergeDedup);
         CPPUNIT_TEST(testMiscellaneous);
         CPPUNIT_TEST(testSplitter);
+        CPPUNIT_TEST(testAutoStrands);
+        CPPUNIT_TEST(testAutoStrandReservation);
         CPPUNIT_TEST(testCleanup);
     CPPUNIT_TEST_SUITE_END();
 protected:
@@ -29639,6 +29787,56 @@ protected:
         doTestSplitter(10);
     }
 
+    void testAutoStrands()
+    {
+        // Disabled, or cheaper than the threshold
+        ASSERT(chooseAutoStrands(5000, 0, 16, 16, 0) == 0);
+        ASSERT(chooseAutoStrands(999, 1000, 16, 16, 0) == 0);
+        // A single activity takes at most half of the spare cores
+        ASSERT(chooseAutoStrands(1000, 1000, 16, 16, 0) == 8);
+        ASSERT(chooseAutoStrands(1000, 1000, 16, 16, 8) == 4);
+        ASSERT(chooseAutoStrands(1000, 1000, 16, 16, 12) == 2);
+        ASSERT(chooseAutoStrands(1000, 1000, 16, 16, 5) == 6);
+        // Too few spare cores to be worth splitting
+        ASSERT(chooseAutoStrands(1000, 1000, 16, 16, 14) == 0);
+        ASSERT(chooseAutoStrands(1000, 1000, 16, 16, 16) == 0);
+        ASSERT(chooseAutoStrands(1000, 1000, 16, 16, 20) == 0);
+        ASSERT(chooseAutoStrands(1000, 1000, 16, 2, 0) == 0);
+        // Limited by coresPerQuery
+        ASSERT(chooseAutoStrands(1000, 1000, 3, 16, 0) == 3);
+        ASSERT(chooseAutoStrands(1000, 1000, 1, 16, 0) == 0);
+        // Successive activities that start while the earlier ones are still running
+        unsigned active = 0;
+        unsigned expected[] = { 8, 4, 2, 0 };
+        for (unsigned i=0; i < 4; i++)
+        {
+            unsigned strands = chooseAutoStrands(2000, 1000, 16, 16, active);
+            ASSERT(strands == expected[i]);
+            active += strands;
+        }
+        ASSERT(active == 14);
+    }
+
+    void testAutoStrandReservation()
+    {
+        // Activities created at the same time must each see the strands reserved by the others
+        std::atomic<unsigned> active{0};
+        unsigned reserved[8];
+        asyncFor(8, 8, [&](unsigned i)
+        {
+            reserved[i] = reserveAutoStrands(2000, 1000, 16, 16, active);
+        });
+        std::sort(reserved, reserved+8);
+        unsigned expected[] = { 0, 0, 0, 0, 0, 2, 4, 8 };
+        for (unsigned i=0; i < 8; i++)
+            ASSERT(reserved[i] == expected[i]);
+        ASSERT(active == 14);
+        // Once one activity has released its strands, they are available to the next
+        active -= 8;
+        ASSERT(reserveAutoStrands(2000, 1000, 16, 16, active) == 5);
+        ASSERT(active == 11);
+    }
+
     void testMiscellaneous()
     {
         DBGLOG("sizeof(CriticalSection)=%u", (unsigned) sizeof(CriticalSection));
@@ -27,9 +27,11 @@
 #include <string>
 #include <sstream>
 #include <map>
+#include <algorithm>
 
 unsigned initIbytiDelay; // In milliseconds
 unsigned minIbytiDelay;  // In milliseconds
+unsigned ibytiDelayPercentile = 0; // If non-zero, only wait for a buddy for this percentile of its recent response times
 
 unsigned ChannelInfo::getIbytiDelay(unsigned primarySubChannel) const  // NOTE - zero-based
 {
@@ -98,6 +100,62 @@ static unsigned *createNewNodeHealthScore(const ServerIdentifier)
 
 static IpMapOf<unsigned> buddyHealth(createNewNodeHealthScore);   // For each buddy IP ever seen, maintains a score of how long I should wait for it to respond when it is the 'first responder'
 
+// Records how long a buddy recently took to send an IBYTI after a packet arrived, when it was the primary for that packet.
+// A packet we give up waiting for is recorded as taking the full delay, so if a buddy regularly misses the current
+// percentile, the delay returns to the one based on its health score.
+
+class BuddyResponseTimes
+{
+public:
+    static constexpr unsigned numSamples = 64;
+    static constexpr unsigned minSamples = 16;
+    static constexpr unsigned recalcInterval = 8;
+
+    void noteResponse(unsigned responseTime)
+    {
+        unsigned seen = ++numSeen;
+        samples[(seen-1) % numSamples] = responseTime;
+        if ((seen >= minSamples) && (seen % recalcInterval == 0))
+        {
+            unsigned num = std::min(seen, numSamples);
+            unsigned values[numSamples];
+            for (unsigned i = 0; i < num; i++)
+                values[i] = samples[i];
+            unsigned pos = std::min(num-1, (num * ibytiDelayPercentile) / 100);
+            std::nth_element(values, values + pos, values + num);
+            percentile = values[pos];
+        }
+    }
+
+    unsigned queryPercentile() const
+    {
+        return percentile;
+    }
+
+private:
+    std::atomic<unsigned> samples[numSamples] = {};
+    std::atomic<unsigned> numSeen{0};
+    std::atomic<unsigned> percentile{(unsigned) -1};    // Not known until we have seen enough samples
+};
+
+static BuddyResponseTimes *createNewNodeResponseTimes(const ServerIdentifier)
+{
+    return new BuddyResponseTimes;
+}
+
+static IpMapOf<BuddyResponseTimes> buddyResponseTimes(createNewNodeResponseTimes);
+
+void noteNodeResponse(const ServerIdentifier &node, unsigned responseTime)
+{
+    if (ibytiDelayPercentile)
+        buddyResponseTimes[node].noteResponse(responseTime);
+}
+
+void noteNodeMissed(const ServerIdentifier &node)
+{
+    noteNodeResponse(node, buddyHealth[node]);
+}
+
 void noteNodeSick(const ServerIdentifier &node)
 {
     // NOTE - IpMapOf is thread safe (we never remove entries). Two threads hitting at the same time may result in the change from one being lost, but that's not a disaster
@@ -116,7 +174,15 @@ void noteNodeHealthy(const ServerIdentifier &node)
 
 unsigned getIbytiDelay(const ServerIdentifier &node)
 {
-    return buddyHealth[node];
+    unsigned delay = buddyHealth[node];
+    if (ibytiDelayPercentile)
+    {
+        // Send a hedged request (by starting work ourselves) once a buddy has taken longer than it usually does
+        unsigned usual = buddyResponseTimes[node].queryPercentile();
+        if (usual < delay)
+            delay = std::max(usual, minIbytiDelay);
+    }
+    return delay;
 }
 
 class CTopologyServer : public CInterfaceOf<ITopologyServer>
@@ -640,6 +706,7 @@ class BuddyHealthTest : public CppUnit::TestFixture
 {
     CPPUNIT_TEST_SUITE(BuddyHealthTest);
     CPPUNIT_TEST(testBuddyHealth);
+    CPPUNIT_TEST(testBuddyResponseTimes);
     CPPUNIT_TEST(testMap);
     CPPUNIT_TEST_SUITE_END();
 
@@ -668,6 +735,42 @@ class BuddyHealthTest : public CppUnit::TestFixture
         CPPUNIT_ASSERT(getIbytiDelay(a2)==minIbytiDelay);
     }
 
+    void testBuddyResponseTimes()
+    {
+        initIbytiDelay = 64;
+        minIbytiDelay = 4;
+        ibytiDelayPercentile = 90;
+        IpAddress a1("123.4.7.1");
+        IpAddress a2("123.4.7.2");
+        for (unsigned i = 0; i < BuddyResponseTimes::minSamples-1; i++)
+            noteNodeResponse(a1, 10);
+        CPPUNIT_ASSERT(getIbytiDelay(a1)==initIbytiDelay);  // Not enough samples yet
+        noteNodeResponse(a1, 10);
+        CPPUNIT_ASSERT(getIbytiDelay(a1)==10);
+        for (unsigned i = 0; i < BuddyResponseTimes::numSamples; i++)
+            noteNodeResponse(a2, 1);
+        CPPUNIT_ASSERT(getIbytiDelay(a2)==minIbytiDelay);
+        ibytiDelayPercentile = 0;
+        CPPUNIT_ASSERT(getIbytiDelay(a2)==initIbytiDelay);
+        ibytiDelayPercentile = 90;
+        // Marking a buddy as sick does not record a response time - only a miss by the primary does
+        for (unsigned i = 0; i < BuddyResponseTimes::numSamples; i++)
+        {
+            noteNodeSick(a2);
+            noteNodeHealthy(a2);
+        }
+        CPPUNIT_ASSERT(getIbytiDelay(a2)==minIbytiDelay);
+        // A buddy that keeps missing the percentile falls back to the delay based on its health
+        for (unsigned i = 0; i < BuddyResponseTimes::numSamples; i++)
+        {
+            noteNodeMissed(a1);
+            noteNodeSick(a1);
+            noteNodeHealthy(a1);
+        }
+        CPPUNIT_ASSERT(getIbytiDelay(a1)==initIbytiDelay);
+        ibytiDelayPercentile = 0;
+    }
+
     void testMap()
     {
         std::map<SocketEndpoint, time_t> serverInstances;
@@ -68,6 +68,7 @@
 
 extern UDPLIB_API unsigned minIbytiDelay;
 extern UDPLIB_API unsigned initIbytiDelay;
+extern UDPLIB_API unsigned ibytiDelayPercentile;
 extern UDPLIB_API SocketEndpoint myAgentEP;
 extern UDPLIB_API unsigned numChannels;
 
@@ -101,6 +102,8 @@ private:
 
 extern UDPLIB_API void noteNodeSick(const ServerIdentifier &node);
 extern UDPLIB_API void noteNodeHealthy(const ServerIdentifier &node);
+extern UDPLIB_API void noteNodeResponse(const ServerIdentifier &node, unsigned responseTime);
+extern UDPLIB_API void noteNodeMissed(const ServerIdentifier &node);
 extern UDPLIB_API unsigned getIbytiDelay(const ServerIdentifier &node);
 
 interface ITopologyServer : public IInterface
@@ -73,9 +73,9 @@ void SwapBigEndian(KeyHdr &hdr)
     _WINREV(hdr.hghtrn);
     _WINREV(hdr.hdrseq);
     _WINREV(hdr.tstamp);
+    _WINREV(hdr.dictionaryHead);
     _WINREV(hdr.rs3[0]);
     _WINREV(hdr.rs3[1]);
-    _WINREV(hdr.rs3[2]);
     _WINREV(hdr.fposOffset);
     _WINREV(hdr.fileSize);
     _WINREV(hdr.nodeKeyLength);
@@ -1166,6 +1166,16 @@ void PayloadReference::clear()
     data.reset();
 }
 
+bool PayloadProjection::overlaps(size32_t start, size32_t end) const
+{
+    for (const auto & range : ranges)
+    {
+        if ((range.first < end) && (start < range.second))
+            return true;
+    }
+    return false;
+}
+
 CJHVarTreeNode::CJHVarTreeNode()
 {
     recArray = NULL;
@@ -19,6 +19,7 @@
 #define CTFILE_HPP
 
 #include <memory>
+#include <vector>
 
 //#define TIME_NODE_SEARCH
 
@@ -28,6 +29,7 @@
 #include "jcrc.hpp"
 #include "jio.hpp"
 #include "jfile.hpp"
+#include "jzstd.hpp"
 
 #define NODESIZE 8192
 
@@ -93,7 +95,8 @@ struct __declspec(novtable) jhtree_decl KeyHdr
     __int64 hghtrn; /* tran# high water mark for idx    a8x */
     __int64 hdrseq; /* wrthdr sequence #            b0x */
     __int64 tstamp; /* update time stamp            b8x */
-    __int64 rs3[3]; /* future use               c0x */
+    __int64 dictionaryHead; /* fpos of the leaf compression dictionary, if present c0x */
+    __int64 rs3[2]; /* future use               c8x */
     __int64 fposOffset; /* amount by which file positions are biased        d8x */
     __int64 fileSize; /* fileSize - was once used in the bias calculation e0x */
     short nodeKeyLength; /* key length in intermediate level nodes e8x */
@@ -126,6 +129,7 @@ enum CompressionType : byte
     ExperimentalCompression = 3,    // Placeholder for testing new compression methods
     NewBlobCompression = 4,         // Blobs encoded with non-lzw compression
     BlockCompression = 5,           // Used for leaves in hybrid indexes
+    ColumnarCompression = 6,        // Hybrid leaves with each payload column compressed separately
 };
 
 //#pragma pack(1)
@@ -175,6 +179,7 @@ protected:
 
     // Extra information that is not in the header, but is key-specific and needs to be accessed from the index nodes.
     const unsigned keyId{0};        // the id of the key - used by event recording for payload expansion
+    Owned<IZStdDictionary> dictionary; // dictionary shared by all the leaf nodes, loaded when the index is opened
 
 public:
     CKeyHdr(unsigned _keyId);
@@ -203,6 +208,9 @@ public:
     inline bool hasSpecialFileposition() const { return true; }
     inline bool isRowCompressed() const { return (hdr.ktype & (HTREE_QUICK_COMPRESSED_KEY|HTREE_VARSIZE)) == HTREE_QUICK_COMPRESSED_KEY; }
     inline offset_t queryBloomHead() const { return hdr.bloomHead; }
+    inline offset_t queryDictionaryHead() const { return (hdr.dictionaryHead == -1) ? 0 : hdr.dictionaryHead; } // indexes created before dictionaries may have FFFF... in this space
+    inline const IZStdDictionary * queryDictionary() const { return dictionary; }
+    void setDictionary(IZStdDictionary * _dictionary) { dictionary.setown(_dictionary); }
     inline unsigned getKeyId() const { return keyId; }
     inline bool containsBlobs() const { return hdr.blobHead != 0; }
     __uint64 getPartitionFieldMask() const
@@ -289,6 +297,18 @@ public:
 
 // Abstract base class for any node that represents a searchable block of keys, either with payloads or with links to other such nodes
 
+// The byte ranges of the payload that a reader uses.  Nodes that store the payload column-wise only expand the
+// columns that overlap these ranges - the rest of the payload in the fetched row is zero filled.
+class jhtree_decl PayloadProjection
+{
+public:
+    void addRange(size32_t start, size32_t end) { ranges.emplace_back(start, end); }
+    bool overlaps(size32_t start, size32_t end) const;
+
+protected:
+    std::vector<std::pair<size32_t, size32_t>> ranges;
+};
+
 class PayloadReference
 {
 public:
@@ -296,6 +316,7 @@ public:
 
 public:
     std::shared_ptr<byte[]> data{nullptr};
+    const PayloadProjection * projection = nullptr; // Not cleared - it is fixed for the lifetime of the cursor
 };
 
 class CJHSearchNode : public CJHTreeNode
@@ -573,6 +594,10 @@ interface IIndexCompressor : public IInterface
     virtual CWriteNodeBase *createNode(offset_t _fpos, CKeyHdr *_keyHdr, NodeType nodeType) const = 0;
     virtual offset_t queryBranchMemorySize() const = 0;
     virtual offset_t queryLeafMemorySize() const = 0;
+    // The number of bytes of rows to sample before the first leaf is created, or 0 if leaves are not compressed with a dictionary
+    virtual size32_t queryDictionaryTrainingSize() const = 0;
+    // Train the dictionary used to compress all the leaves.  Returns the dictionary to store in the index, or nullptr if none is used.
+    virtual IZStdDictionary * trainDictionary(unsigned numSamples, const size_t * sampleSizes, const void * samples) = 0;
 };
 
 
@@ -83,14 +83,35 @@ int CJHBlockCompressedSearchNode::locateGT(const char * search, unsigned minInde
     return a;
 }
 
-char *CJHBlockCompressedSearchNode::expandBlock(const void *src, size32_t &decompressedSize, CompressionMethod compressionMethod)
+// Creating a zstd decompression stream and attaching a dictionary to it is expensive compared with expanding a
+// single leaf, so each thread keeps the expander for the dictionary it used most recently.  The expander links the
+// dictionary, so the pointer comparison cannot match a different dictionary allocated at the same address.
+static thread_local Owned<IExpander> dictionaryExpander;
+static thread_local const IZStdDictionary * dictionaryExpanderDictionary = nullptr;
+
+static IExpander * queryDictionaryExpander(const IZStdDictionary * dictionary)
+{
+    if (dictionaryExpanderDictionary != dictionary)
+    {
+        dictionaryExpander.setown(createZStdStreamExpander(dictionary));
+        dictionaryExpanderDictionary = dictionary;
+    }
+    return dictionaryExpander;
+}
+
+char *CJHBlockCompressedSearchNode::expandBlock(const void *src, size32_t &decompressedSize, CompressionMethod compressionMethod) const
 {
     ICompressHandler * handler = queryCompressHandler(compressionMethod);
     if (!handler)
         throw makeStringExceptionV(JHTREE_KEY_UNKNOWN_COMPRESSION, "Unknown payload compression method %d", (int)compressionMethod);
 
     const char * options = nullptr;
-    Owned<IExpander> exp = handler->getExpander(options);
+    Linked<IExpander> exp;
+    const IZStdDictionary * dictionary = keyHdr->queryDictionary();
+    if (dictionary && (handler->queryPersistMethod() == COMPRESS_METHOD_ZSTDS))
+        exp.set(queryDictionaryExpander(dictionary));
+    else
+        exp.setown(handler->getExpander(options));
 
     int len=exp->init(src);
     if (len==0)
@@ -313,6 +334,152 @@ offset_t CJHBlockCompressedVarNode::getFPosAt(unsigned int num) const
 
 //=========================================================================================================
 
+// A columnar leaf contains the sequence number of the first row, the compression method and zero filepos flag, the
+// number of columns, then a table of {offset, size, compressed size} for each column followed by the compressed columns.
+// Column 0 contains the keyed fields and the file position of each row, the remaining columns are payload fields.
+static constexpr size32_t columnarHeaderSize = sizeof(unsigned __int64) + sizeof(CompressionMethod) + sizeof(bool) + sizeof(unsigned short);
+static constexpr size32_t columnarEntrySize = sizeof(unsigned short) + sizeof(unsigned short) + sizeof(unsigned);
+static constexpr size32_t minColumnSpace = 32;      // Some compressors refuse to open smaller buffers
+
+CJHColumnarLeafNode::~CJHColumnarLeafNode()
+{
+    for (unsigned i=1; i < numColumns; i++)
+    {
+        char * expanded = columns[i].expanded.load(std::memory_order_acquire);
+        if (expanded)
+            releaseMem(expanded, hdr.numKeys * columns[i].size);
+    }
+}
+
+void CJHColumnarLeafNode::load(CKeyHdr *_keyHdr, const void *rawData, offset_t _fpos, bool needCopy)
+{
+    CJHSearchNode::load(_keyHdr, rawData, _fpos, needCopy);
+
+    keyLen = keyHdr->getMaxKeyLength();
+    keyCompareLen = keyHdr->getNodeKeyLength();
+
+    const char *data = ((const char *) rawData) + sizeof(hdr);
+
+    memcpy(&firstSequence, data, sizeof(firstSequence));
+    data += sizeof(firstSequence);
+    _WINREV(firstSequence);
+
+    compressionMethod = *(const CompressionMethod *) data;
+    data += sizeof(CompressionMethod);
+
+    zeroFilePosition = *(const bool *) data;
+    data += sizeof(bool);
+
+    unsigned short numCols;
+    memcpy(&numCols, data, sizeof(numCols));
+    data += sizeof(numCols);
+    _WINREV(numCols);
+    if (numCols == 0)
+        throw MakeStringException(0, "Htree: Corrupt columnar key node detected");
+
+    numColumns = numCols;
+    columns.reset(new Column[numColumns]);
+    const char * compressed = data + numColumns * columnarEntrySize;
+    for (unsigned i=0; i < numColumns; i++)
+    {
+        Column & column = columns[i];
+        unsigned short offset, size;
+        unsigned compressedSize;
+        memcpy(&offset, data, sizeof(offset));
+        memcpy(&size, data + sizeof(offset), sizeof(size));
+        memcpy(&compressedSize, data + sizeof(offset) + sizeof(size), sizeof(compressedSize));
+        data += columnarEntrySize;
+        _WINREV(offset);
+        _WINREV(size);
+        _WINREV(compressedSize);
+        column.offset = offset;
+        column.size = size;
+        column.compressedSize = compressedSize;
+        column.compressed = compressed;
+        compressed += compressedSize;
+    }
+
+    keyRecLen = columns[0].size;
+    CCycleTimer expansionTimer(true);
+    keyBuf = expandBlock(columns[0].compressed, inMemorySize, compressionMethod);
+    loadExpandTime = expansionTimer.elapsedNs();
+
+    //The payload columns are only expanded when they are used, so keep a copy of the compressed data
+    const char * payloadStart = columns[0].compressed + columns[0].compressedSize;
+    compressedPayload.set(compressed - payloadStart, payloadStart);
+    for (unsigned i=1; i < numColumns; i++)
+        columns[i].compressed = (const char *)compressedPayload.get() + (columns[i].compressed - payloadStart);
+    columns[0].compressed = nullptr;
+
+    //Account for the fully expanded payload since columns are never released while the node is cached
+    inMemorySize += compressedPayload.length() + hdr.numKeys * (keyLen - keyCompareLen);
+    fileposFetchSize = keyHdr->hasSpecialFileposition() && !zeroFilePosition ? sizeof(offset_t) : 0;
+    clearFilepos = keyHdr->hasSpecialFileposition() && zeroFilePosition;
+}
+
+const char * CJHColumnarLeafNode::queryColumn(const Column & column) const
+{
+    char * expanded = column.expanded.load(std::memory_order_acquire);
+    if (expanded)
+        return expanded;
+
+    size32_t expandedSize;
+    char * data = expandBlock(column.compressed, expandedSize, compressionMethod);
+    if (expandedSize != hdr.numKeys * column.size)
+    {
+        releaseMem(data, expandedSize);
+        throw MakeStringException(0, "Htree: Corrupt columnar key node detected");
+    }
+
+    //Another thread may be expanding the same column - the first one to finish wins
+    if (!column.expanded.compare_exchange_strong(expanded, data, std::memory_order_acq_rel))
+    {
+        releaseMem(data, expandedSize);
+        return expanded;
+    }
+    return data;
+}
+
+bool CJHColumnarLeafNode::fetchPayload(unsigned int index, char *dst, PayloadReference & activePayload) const
+{
+    if (index >= hdr.numKeys) return false;
+    if (!dst) return true;
+
+    const PayloadProjection * projection = activePayload.projection;
+    for (unsigned i=1; i < numColumns; i++)
+    {
+        const Column & column = columns[i];
+        if (projection && !projection->overlaps(column.offset, column.offset + column.size))
+        {
+            //Clear the columns that are not fetched, so the row never contains values from a previous row
+            memset(dst + column.offset, 0, column.size);
+            continue;
+        }
+        const char * values = queryColumn(column);
+        memcpy(dst + column.offset, values + index * column.size, column.size);
+    }
+
+    if (fileposFetchSize)
+        memcpy(dst + keyLen, keyBuf + index*keyRecLen + keyCompareLen, fileposFetchSize);
+    else if (clearFilepos)
+        *(offset_t*)(dst+keyLen) = 0;
+    return true;
+}
+
+offset_t CJHColumnarLeafNode::getFPosAt(unsigned int index) const
+{
+    if (index >= hdr.numKeys) return 0;
+    if (zeroFilePosition) return 0;
+
+    offset_t pos;
+    const char * p = keyBuf + index*keyRecLen + keyCompareLen;
+    memcpy( &pos, p, sizeof(__int64));
+    _WINREV(pos);
+    return pos;
+}
+
+//=========================================================================================================
+
 CBlockCompressedWriteNode::CBlockCompressedWriteNode(offset_t _fpos, CKeyHdr *_keyHdr, bool isLeafNode, const CBlockCompressedBuildContext& ctx) : 
     CWriteNode(_fpos, _keyHdr, isLeafNode), context(ctx)
 {
@@ -379,6 +546,157 @@ void CBlockCompressedWriteNode::finalize()
 
 //=========================================================================================================
 
+CColumnarWriteNode::CColumnarWriteNode(offset_t _fpos, CKeyHdr *_keyHdr, const CBlockCompressedBuildContext& ctx) :
+    CWriteNode(_fpos, _keyHdr, true), context(ctx)
+{
+    hdr.compressionType = ColumnarCompression;
+    keyLen = keyHdr->getMaxKeyLength();
+    keyedLen = keyHdr->getNodeKeyLength();
+    lastKeyValue = (char *) malloc(keyLen);
+}
+
+CColumnarWriteNode::~CColumnarWriteNode()
+{
+    free(lastKeyValue);
+}
+
+bool CColumnarWriteNode::compressRows()
+{
+    size32_t keyedRecLen = keyedLen + (context.zeroFilePos ? 0 : sizeof(offset_t));
+    size32_t payloadLen = keyLen - keyedLen;
+    unsigned numRows = keyedRows.length() / keyedRecLen;
+    unsigned numColumns = context.payloadColumns.size() + 1;
+    size32_t headerSize = columnarHeaderSize + numColumns * columnarEntrySize;
+    if (headerSize >= (size32_t)maxBytes)
+        return false;
+
+    char * entry = keyPtr + columnarHeaderSize;
+    char * target = keyPtr + headerSize;
+    size32_t remaining = maxBytes - headerSize;
+    ICompressor * compressor = context.compressor;
+    for (unsigned col = 0; col < numColumns; col++)
+    {
+        size32_t offset = 0;
+        size32_t size = keyedRecLen;
+        const void * values = keyedRows.toByteArray();
+        if (col != 0)
+        {
+            offset = context.payloadColumns[col-1];
+            size32_t next = (col < numColumns-1) ? context.payloadColumns[col] : keyLen;
+            size = next - offset;
+
+            //Gather the values of this column from each row so they are compressed together
+            char * column = (char *)columnBuffer.clear().reserveTruncate(numRows * size);
+            const char * payload = payloadRows.toByteArray() + (offset - keyedLen);
+            for (unsigned row = 0; row < numRows; row++)
+                memcpy(column + row * size, payload + row * payloadLen, size);
+            values = column;
+        }
+
+        size32_t len = numRows * size;
+        if (remaining < minColumnSpace)
+            return false;
+        compressor->open(target, remaining, size, false);
+        bool fits = (compressor->write(values, len) == len);
+        compressor->close();
+        if (!fits)
+            return false;
+
+        assertex((offset <= 0xffff) && (size <= 0xffff));   // checked when the compressor was created
+        unsigned short roffset = offset;
+        unsigned short rsize = size;
+        unsigned rcompressedSize = compressor->buflen();
+        target += rcompressedSize;
+        remaining -= rcompressedSize;
+        _WINREV(roffset);
+        _WINREV(rsize);
+        _WINREV(rcompressedSize);
+        memcpy(entry, &roffset, sizeof(roffset));
+        memcpy(entry + sizeof(roffset), &rsize, sizeof(rsize));
+        memcpy(entry + sizeof(roffset) + sizeof(rsize), &rcompressedSize, sizeof(rcompressedSize));
+        entry += columnarEntrySize;
+    }
+
+    char * header = keyPtr;
+    unsigned __int64 rsequence = firstSequence;
+    _WINREV(rsequence);
+    memcpy(header, &rsequence, sizeof(rsequence));
+    header += sizeof(rsequence);
+    memcpy(header, &context.compressionMethod, sizeof(context.compressionMethod));
+    header += sizeof(context.compressionMethod);
+    *(bool*)header = context.zeroFilePos;
+    header += sizeof(bool);
+    unsigned short rcolumns = numColumns;
+    _WINREV(rcolumns);
+    memcpy(header, &rcolumns, sizeof(rcolumns));
+
+    hdr.keyBytes = target - keyPtr;
+    compressedSize = hdr.keyBytes;
+    uncompressedSize = 0;
+    dirty = false;
+    return true;
+}
+
+bool CColumnarWriteNode::add(offset_t pos, const void *indata, size32_t insize, unsigned __int64 sequence)
+{
+    if (0xffff == hdr.numKeys)
+        return false;
+    if (insize != keyLen)
+        throw MakeStringException(0, "key+payload (%u) does not match the fixed length (%u) required by a columnar index", insize, keyLen);
+
+    if (hdr.numKeys == 0)
+        firstSequence = sequence;
+
+    size32_t prevKeyedSize = keyedRows.length();
+    size32_t prevPayloadSize = payloadRows.length();
+    keyedRows.append(keyedLen, indata);
+    if (!context.zeroFilePos)
+    {
+        offset_t rpos = pos;
+        _WINREV(rpos);
+        keyedRows.append(sizeof(rpos), &rpos);
+    }
+    payloadRows.append(keyLen - keyedLen, (const char *)indata + keyedLen);
+
+    //Compressing every column for every row would be very slow, so only recompress the rows once a pessimistic
+    //estimate (assuming the new rows expand by 100%) may no longer fit.
+    size32_t rowSize = (keyedRows.length() - prevKeyedSize) + (payloadRows.length() - prevPayloadSize);
+    size32_t numColumns = context.payloadColumns.size() + 1;
+    size32_t estimate = compressedSize + 2 * (uncompressedSize + rowSize) + columnarHeaderSize + numColumns * (columnarEntrySize + minColumnSpace);
+    if (estimate > (size32_t)maxBytes)
+    {
+        if (!compressRows())
+        {
+            keyedRows.setLength(prevKeyedSize);
+            payloadRows.setLength(prevPayloadSize);
+            dirty = true;   // the node image no longer matches the rows
+            return false;
+        }
+    }
+    else
+    {
+        uncompressedSize += rowSize;
+        dirty = true;
+    }
+
+    memcpy(lastKeyValue, indata, insize);
+    lastSequence = sequence;
+    hdr.numKeys++;
+    memorySize += insize + sizeof(pos);
+    return true;
+}
+
+void CColumnarWriteNode::finalize()
+{
+    if (hdr.numKeys && dirty)
+    {
+        if (!compressRows())
+            throw MakeStringException(0, "Failed to compress columnar index node");
+    }
+}
+
+//=========================================================================================================
+
 void CBlockCompressedBuildContext::initCompressor()
 {
     compressionHandler = queryCompressHandler(compressionMethod);
@@ -416,6 +734,15 @@ HybridIndexCompressor::HybridIndexCompressor(unsigned keyedSize, const CKeyHdr*
             if (blobMethod != COMPRESS_METHOD_NONE)
                 blobCompression = blobMethod;
         }
+        else if (strieq(option, "dictionary"))
+        {
+            offset_t size = streq(value, "1") ? defaultDictionarySize : friendlyStringToSize(value);
+            dictionarySize = (size32_t)std::min(size, (offset_t)maxDictionarySize);
+        }
+        else if (strieq(option, "columnar"))
+        {
+            leafContext.columnar = strToBool(value);
+        }
         else
         {
             //ignore any unrecognised options
@@ -427,10 +754,48 @@ HybridIndexCompressor::HybridIndexCompressor(unsigned keyedSize, const CKeyHdr*
         processOptionString(colon+1, processOption);
 
     leafContext.initCompressor();
+    if (dictionarySize && (leafContext.compressionHandler->queryPersistMethod() != COMPRESS_METHOD_ZSTDS))
+    {
+        OWARNLOG("Index leaf compression dictionaries are only supported for zstds compression - option ignored");
+        dictionarySize = 0;
+    }
 
     if (!isTLK && helper && (helper->getFlags() & TIWzerofilepos))
         leafContext.zeroFilePos = true;
 
+    //Columnar leaves are only supported for fixed size rows with a payload, with each payload field in its own column
+    size32_t keyedLen = keyedSize;
+    size32_t keyLen = keyHdr->getMaxKeyLength();
+    if (leafContext.columnar && (isTLK || keyHdr->isVariable() || (keyLen <= keyedLen)))
+        leafContext.columnar = false;
+    if (leafContext.columnar)
+    {
+        leafContext.payloadColumns.push_back(keyedLen);
+        IOutputMetaData * format = helper ? helper->queryDiskRecordSize() : nullptr;
+        if (format)
+        {
+            const RtlRecord & recInfo = format->queryRecordAccessor(true);
+            for (unsigned idx = 0; idx < recInfo.getNumFields(); idx++)
+            {
+                if (!recInfo.isFixedOffset(idx))
+                    break;
+                size32_t offset = recInfo.getFixedOffset(idx);
+                if ((offset > keyedLen) && (offset < keyLen))
+                    leafContext.payloadColumns.push_back(offset);
+            }
+        }
+
+        //The column offsets and sizes are stored as 16bit values, and the column table must leave room for the
+        //data, otherwise use the row based block compressed leaves.
+        size32_t columnTableSize = columnarHeaderSize + (leafContext.payloadColumns.size() + 1) * columnarEntrySize;
+        if ((keyLen + sizeof(offset_t) > 0xffff) || (columnTableSize > keyHdr->getNodeSize() / 4))
+        {
+            OWARNLOG("Columnar index leaves are not supported for rows of %u bytes with %u payload columns - using row based leaves", keyLen, (unsigned)leafContext.payloadColumns.size());
+            leafContext.columnar = false;
+            leafContext.payloadColumns.clear();
+        }
+    }
+
     branchCompressor.setown(new InplaceIndexCompressor(keyedSize, keyHdr, helper, compression));
 }
 
@@ -439,6 +804,8 @@ CWriteNodeBase *HybridIndexCompressor::createNode(offset_t _fpos, CKeyHdr *_keyH
     switch (nodeType)
     {
     case NodeLeaf:
+        if (leafContext.columnar)
+            return new CColumnarWriteNode(_fpos, _keyHdr, leafContext);
         return new CBlockCompressedWriteNode(_fpos, _keyHdr, true, leafContext);
     case NodeBranch:
         return branchCompressor->createNode(_fpos, _keyHdr, nodeType);
@@ -458,3 +825,35 @@ offset_t HybridIndexCompressor::queryLeafMemorySize() const
 {
     return 0;
 }
+
+size32_t HybridIndexCompressor::queryDictionaryTrainingSize() const
+{
+    return std::min(dictionarySize * dictionarySampleFactor, maxDictionaryTrainingSize);
+}
+
+IZStdDictionary * HybridIndexCompressor::trainDictionary(unsigned numSamples, const size_t * sampleSizes, const void * samples)
+{
+    Owned<IZStdDictionary> dictionary = trainZStdDictionary(dictionarySize, numSamples, sampleSizes, samples);
+    if (dictionary)
+    {
+        //The level is normally supplied by the compression alias, so it needs to be passed explicitly to the dictionary compressor
+        StringBuffer options;
+        switch (leafContext.compressionMethod)
+        {
+        case COMPRESS_METHOD_ZSTDS3:
+            options.append("level=3");
+            break;
+        case COMPRESS_METHOD_ZSTDS6:
+            options.append("level=6");
+            break;
+        case COMPRESS_METHOD_ZSTDS9:
+            options.append("level=9");
+            break;
+        default:
+            break;
+        }
+        options.append(leafContext.compressionOptions);
+        leafContext.compressor.setown(createZStdStreamCompressor(options, dictionary));
+    }
+    return dictionary.getClear();
+}
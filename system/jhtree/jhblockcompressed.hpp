@@ -18,6 +18,7 @@
 #ifndef JHBLOCK_COMPRESSED_HPP
 #define JHBLOCK_COMPRESSED_HPP
 
+#include <atomic>
 #include "jiface.hpp"
 #include "jhutil.hpp"
 #include "hlzw.h"
@@ -40,7 +41,7 @@ protected:
 
     inline size32_t getKeyLen() const { return keyLen; }
 
-    char* expandBlock(const void* src, size32_t &decompressedSize, CompressionMethod compressionMethod);
+    char* expandBlock(const void* src, size32_t &decompressedSize, CompressionMethod compressionMethod) const;
 public:
     //These are the key functions that need to be implemented for a node that can be searched
     inline size32_t getNumKeys() const { return hdr.numKeys; }
@@ -71,6 +72,33 @@ public:
     virtual int compareValueAt(const char *src, unsigned int index) const;
 };
 
+// A fixed size leaf where the keyed fields (and file positions) are compressed as one block, and each payload column
+// is compressed separately.  Columns are only expanded when a row that needs them is fetched.
+class CJHColumnarLeafNode final : public CJHBlockCompressedSearchNode
+{
+    struct Column
+    {
+        size32_t offset = 0;
+        size32_t size = 0;
+        size32_t compressedSize = 0;
+        const char * compressed = nullptr;
+        mutable std::atomic<char *> expanded{nullptr};
+    };
+
+    std::unique_ptr<Column[]> columns;
+    unsigned numColumns = 0;
+    CompressionMethod compressionMethod = COMPRESS_METHOD_NONE;
+    MemoryAttr compressedPayload;
+
+    const char * queryColumn(const Column & column) const;
+public:
+    ~CJHColumnarLeafNode();
+
+    virtual void load(CKeyHdr *keyHdr, const void *rawData, offset_t pos, bool needCopy) override;
+    virtual bool fetchPayload(unsigned int num, char *dest, PayloadReference & activePayload) const override;
+    virtual offset_t getFPosAt(unsigned int num) const override;
+};
+
 class CJHNewBlobNode final : public CJHBlobNode
 {
 public:
@@ -90,6 +118,8 @@ public:
     StringBuffer compressionOptions;
     CompressionMethod compressionMethod = COMPRESS_METHOD_ZSTDS6;
     bool zeroFilePos = false;
+    bool columnar = false;
+    std::vector<size32_t> payloadColumns;   // offset of the start of each payload column in a columnar leaf
 };
 
 class jhtree_decl CBlockCompressedWriteNode : public CWriteNode
@@ -112,13 +142,48 @@ public:
     virtual size32_t getMemorySize() const override { return memorySize; }
 };
 
+class jhtree_decl CColumnarWriteNode : public CWriteNode
+{
+private:
+    MemoryBuffer keyedRows;         // keyed fields and file position of each row
+    MemoryBuffer payloadRows;       // payload of each row - only split into columns when the node is compressed
+    MemoryBuffer columnBuffer;
+    char *lastKeyValue = nullptr;
+    unsigned __int64 firstSequence = 0;
+    unsigned __int64 lastSequence = 0;
+    size32_t keyLen = 0;
+    size32_t keyedLen = 0;
+    size32_t memorySize = 0;
+    size32_t compressedSize = 0;    // size of the node image when it was last compressed
+    size32_t uncompressedSize = 0;  // size of the rows added since the node was last compressed
+    bool dirty = false;
+    const CBlockCompressedBuildContext& context;
+
+    bool compressRows();
+public:
+    CColumnarWriteNode(offset_t fpos, CKeyHdr *keyHdr, const CBlockCompressedBuildContext& ctx);
+    ~CColumnarWriteNode();
+
+    virtual bool add(offset_t pos, const void *data, size32_t size, unsigned __int64 sequence) override;
+    virtual void finalize() override;
+    virtual const void *getLastKeyValue() const override { return lastKeyValue; }
+    virtual unsigned __int64 getLastSequence() const override { return lastSequence; }
+    virtual size32_t getMemorySize() const override { return memorySize; }
+};
+
 //---------------------------------------------------------------------------------------------------------------------
 class HybridIndexCompressor : public CInterfaceOf<IIndexCompressor>
 {
 protected:
+    static constexpr size32_t defaultDictionarySize = 0x8000;
+    static constexpr size32_t maxDictionarySize = 0x100000;
+    static constexpr unsigned dictionarySampleFactor = 100; // zstd recommends ~100x the dictionary size of training data
+    static constexpr size32_t maxDictionaryTrainingSize = 0x2000000; // limit the rows buffered by the builder to 32MB
+
     Owned<IIndexCompressor> branchCompressor;
     CBlockCompressedBuildContext leafContext;
     CompressionMethod blobCompression = COMPRESS_METHOD_ZSTD6;
+    size32_t dictionarySize = 0;
 public:
     HybridIndexCompressor(unsigned keyedSize, const CKeyHdr* keyHdr, IHThorIndexWriteArg *helper, const char * compression, bool isTLK);
 
@@ -126,6 +191,8 @@ public:
     virtual CWriteNodeBase *createNode(offset_t _fpos, CKeyHdr *_keyHdr, NodeType nodeType) const override;
     virtual offset_t queryBranchMemorySize() const override;
     virtual offset_t queryLeafMemorySize() const override;
+    virtual size32_t queryDictionaryTrainingSize() const override;
+    virtual IZStdDictionary * trainDictionary(unsigned numSamples, const size_t * sampleSizes, const void * samples) override;
 };
 
 #endif
@@ -1599,7 +1599,7 @@ int InplaceNodeSearcher::compareValueAtFallback(const char *src, unsigned int in
 InplaceKeyBuildContext::~InplaceKeyBuildContext()
 {
 #ifdef TRACE_BUILDING_STATS
-    DBGLOG("NumDuplicates = %u  DataSize(%llu) KeyedSize(%llu), NumLeaves(%llu), BlockCompress(%llu)", numKeyedDuplicates, totalDataSize, totalKeyedSize, numLeafNodes, numBlockCompresses);
+    DBGLOG("NumDuplicates = %u  DataSize(%llu) KeyedSize(%llu), NumLeaves(%llu), BlockCompress(%llu)", numKeyedDuplicates.load(), totalDataSize.load(), totalKeyedSize.load(), numLeafNodes, numBlockCompresses);
 #endif
 
     delete [] nullRow;
@@ -1618,6 +1618,8 @@ CJHInplaceTreeNode::~CJHInplaceTreeNode()
 {
     if (ownedPayload)
         delete [] payload;
+    if (mappedKeyBuf)
+        keyBuf = nullptr;   // Points into the memory mapped file - must not be freed by the base class
 }
 
 int CJHInplaceTreeNode::compareValueAt(const char *src, unsigned int index) const
@@ -1725,10 +1727,19 @@ void CJHInplaceTreeNode::load(CKeyHdr *_keyHdr, const void *rawData, offset_t _f
 
         size32_t padding = 8 - 1; // Ensure that unsigned8 values can be read "legally"
 
-        keyBuf = (char *) allocMem(copyLen + padding);
-        memcpy(keyBuf, originalData, copyLen);
-        memset(keyBuf+copyLen, 0, padding);
-        inMemorySize = copyLen+padding;
+        //Memory mapped nodes can be searched where they are, provided the padding is still within the node
+        if (!needCopy && (sizeof(hdr) + copyLen + padding <= keyHdr->getNodeSize()))
+        {
+            keyBuf = (char *) originalData;
+            mappedKeyBuf = true;
+        }
+        else
+        {
+            keyBuf = (char *) allocMem(copyLen + padding);
+            memcpy(keyBuf, originalData, copyLen);
+            memset(keyBuf+copyLen, 0, padding);
+            inMemorySize = copyLen+padding;
+        }
 
         /**** If any of the following code changes queryPayload() must also be changed. ******/
 
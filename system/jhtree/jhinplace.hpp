@@ -166,13 +166,14 @@ public:
     const byte * nullRow = nullptr;
 
     //Various stats gathered when building the index
-    unsigned numKeyedDuplicates = 0;
-    offset_t totalKeyedSize = 0;
-    offset_t totalDataSize = 0;
+    //Leaf nodes may be serialized in parallel (see CKeyBuilder), so the stats updated by write() are atomic
+    RelaxedAtomic<unsigned> numKeyedDuplicates{0};
+    RelaxedAtomic<offset_t> totalKeyedSize{0};
+    RelaxedAtomic<offset_t> totalDataSize{0};
     offset_t numLeafNodes = 0;
     offset_t numBlockCompresses = 0;
     offset_t branchMemorySize = 0;
-    offset_t leafMemorySize = 0;
+    RelaxedAtomic<offset_t> leafMemorySize{0};
     struct {
         double minCompressionThreshold = 0.95; // use uncompressed if compressed is > 95% uncompressed
         unsigned maxCompressionFactor = defaultMaxCompressionFactor;   // Avoid compressing more than a set limit because allocating when expanding is painful.
@@ -214,6 +215,7 @@ protected:
     byte bytesPerPosition = 0;
     bool ownedPayload = false;
     bool expandPayloadOnDemand = false;
+    bool mappedKeyBuf = false;
 };
 
 
@@ -356,6 +358,14 @@ public:
     {
         return ctx.leafMemorySize;
     }
+    virtual size32_t queryDictionaryTrainingSize() const override
+    {
+        return 0;
+    }
+    virtual IZStdDictionary * trainDictionary(unsigned numSamples, const size_t * sampleSizes, const void * samples) override
+    {
+        throwUnexpected();
+    }
 
 protected:
     StringAttr compressionName;
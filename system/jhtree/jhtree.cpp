@@ -45,6 +45,7 @@
 #include <limits.h>
 #ifdef __linux__
 #include <alloca.h>
+#include <sys/mman.h>
 #endif
 #include <utility>
 #include <algorithm>
@@ -79,6 +80,7 @@ static CriticalSection *initCrit = NULL;
 static cycle_t fetchThresholdCycles = 0;
 
 bool useMemoryMappedIndexes = false;
+offset_t residentIndexMaxSize = 0;
 bool linuxYield = false;
 bool flushJHtreeCacheOnOOM = true;
 std::atomic<unsigned __int64> branchSearchCycles{0};
@@ -388,6 +390,38 @@ protected:
     Owned<const IDynamicTransform> layoutTrans;
     MemoryBuffer buf;  // used when translating
     size32_t layoutSize = 0;
+
+    const RtlRecord * indexFormat = nullptr;
+    const RtlRecord * projectedFormat = nullptr;
+    std::unique_ptr<PayloadProjection> projection;
+
+    void updatePayloadProjection()
+    {
+        projection.reset();
+        if (!indexFormat || !projectedFormat)
+            return;
+
+        //Only fixed offset payload fields can be projected - otherwise the whole payload is fetched.
+        //A projected field is matched to an index field by name (as the layout translator does), and must also
+        //have the same type.  If the types differ the whole payload is fetched, rather than relying on the name.
+        std::unique_ptr<PayloadProjection> fields(new PayloadProjection);
+        unsigned numFields = indexFormat->getNumFields();
+        for (unsigned idx = indexFormat->getNumKeyedFields(); idx < numFields; idx++)
+        {
+            if (!indexFormat->isFixedOffset(idx+1))
+                return;
+            unsigned projectedIdx = projectedFormat->getFieldNum(indexFormat->queryName(idx));
+            if (projectedIdx != (unsigned)-1)
+            {
+                const RtlTypeInfo * indexType = indexFormat->queryType(idx);
+                const RtlTypeInfo * projectedType = projectedFormat->queryType(projectedIdx);
+                if ((indexType->fieldType != projectedType->fieldType) || (indexType->length != projectedType->length))
+                    return;
+                fields->addRange(indexFormat->getFixedOffset(idx), indexFormat->getFixedOffset(idx+1));
+            }
+        }
+        projection.swap(fields);
+    }
 public:
     IMPLEMENT_IINTERFACE;
 
@@ -431,6 +465,9 @@ public:
             keyCursor = ki->getCursor(filter, logExcessiveSeeks);
             keyedSize = ki->keyedSize();
             filter->updateIndexFormat(actualRecInfo);
+            indexFormat = &actualRecInfo;
+            updatePayloadProjection();
+            keyCursor->setPayloadProjection(projection.get());
             partitionFieldMask = ki->getPartitionFieldMask();
             indexParts = ki->numPartitions();
 
@@ -589,6 +626,14 @@ public:
         layoutTrans.set(trans);
     }
 
+    virtual void setPayloadProjection(const RtlRecord * projected) override
+    {
+        projectedFormat = projected;
+        updatePayloadProjection();
+        if (keyCursor)
+            keyCursor->setPayloadProjection(projection.get());
+    }
+
     virtual void finishSegmentMonitors()
     {
         filter->finish(keyedSize);
@@ -979,6 +1024,12 @@ public:
     }
     const CJHTreeNode *getCachedNode(const INodeLoader & nodeLoader,unsigned keyID, offset_t pos, NodeType type, IContextLogger *ctx, bool isTLK);
     void getCacheInfo(ICacheInfoRecorder &cacheInfo);
+    __uint64 getStatisticValue(NodeType type, StatisticKind kind) const
+    {
+        if ((unsigned)type >= CacheMax)
+            return 0;
+        return cache[type].getStatisticValue(kind);
+    }
 
     inline size_t setNodeCacheMem(size_t newSize)
     {
@@ -1386,6 +1437,7 @@ void CKeyIndex::init(KeyHdr &hdr, const INodeLoader & nodeLoader)
     try
     {
         keyHdr->load(hdr);
+        loadDictionary(nodeLoader);
         ensureBloomFiltersLoaded(nodeLoader);
         rootNode = getRootNode(nodeLoader);
     }
@@ -1401,6 +1453,8 @@ void CKeyIndex::init(KeyHdr &hdr, const INodeLoader & nodeLoader)
 
 CKeyIndex::~CKeyIndex()
 {
+    for (offset_t i = 0; i < numResidentNodes; i++)
+        ::Release(residentNodes[i].load(std::memory_order_relaxed));
     ::Release(keyHdr);
     ::Release(cache);
     ::Release(rootNode);
@@ -1454,9 +1508,26 @@ void CMemKeyIndex::ensureReady()
 
     DefaultNodeLoader loader(*this); // Will never actually be used
     init(hdr, loader);
+    if (residentIndexMaxSize && (io->fileSize() <= residentIndexMaxSize))
+        makeResident();
     initialised.store(true, std::memory_order_release);
 }
 
+void CMemKeyIndex::makeResident()
+{
+    //Nodes are loaded on first use and then kept until the index is released, so searches avoid the node cache
+    //locks and never reload an evicted node.  Node positions are always a multiple of the node size.
+    numResidentNodes = io->fileSize() / keyHdr->getNodeSize();
+    residentNodes.reset(new std::atomic<const CJHTreeNode *>[numResidentNodes]());
+#ifdef __linux__
+    //Read the whole mapping ahead so the first searches do not fault, and back it with huge pages if the kernel supports it
+    madvise(io->base(), io->length(), MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+    madvise(io->base(), io->length(), MADV_HUGEPAGE);
+#endif
+#endif
+}
+
 
 //---------------------------------------------------------------------------------------------------------------------
 
@@ -1610,6 +1681,9 @@ CJHTreeNode *CKeyIndex::_createNode(const NodeHdr &nodeHdr) const
             return new CJHBlockCompressedVarNode();
         else
             return new CJHBlockCompressedSearchNode();
+    case ColumnarCompression:
+        assertex(nodeHdr.nodeType== NodeLeaf);
+        return new CJHColumnarLeafNode();
     case NewBlobCompression:
         assertex(nodeHdr.nodeType== NodeBlob);    // Should only be using the NewBlobCompression for blob nodes
         return new CJHNewBlobNode();
@@ -1670,10 +1744,37 @@ IKeyCursor *CKeyIndex::getCursor(const IIndexFilterList *filter, bool logExcessi
 const CJHSearchNode *CKeyIndex::getIndexNodeUsingLoader(const INodeLoader &nodeLoader, offset_t offset, NodeType type, IContextLogger *ctx) const
 {
     latestGetNodeOffset = offset;
+    if (residentNodes && (type != NodeMeta) && (type != NodeBloom))
+    {
+        const CJHSearchNode * node = getResidentNode(nodeLoader, offset);
+        if (node)
+            return node;
+    }
     //Call isTLK() rather than isTopLevelKey() so the test is inlined (rather than a virtual)
     return (CJHSearchNode *)cache->getCachedNode(nodeLoader, iD, offset, type, ctx, isTLK());
 }
 
+const CJHSearchNode *CKeyIndex::getResidentNode(const INodeLoader &nodeLoader, offset_t offset) const
+{
+    size32_t nodeSize = keyHdr->getNodeSize();
+    offset_t slot = offset / nodeSize;
+    if (!offset || (offset % nodeSize) || (slot >= numResidentNodes))
+        return nullptr;
+
+    std::atomic<const CJHTreeNode *> & entry = residentNodes[slot];
+    const CJHTreeNode * node = entry.load(std::memory_order_acquire);
+    if (!node)
+    {
+        const CJHTreeNode * loaded = nodeLoader.loadNode(nullptr, offset);
+        if (entry.compare_exchange_strong(node, loaded, std::memory_order_acq_rel))
+            node = loaded;
+        else
+            loaded->Release();      // Another thread loaded it first, node is now set to that copy
+    }
+    node->Link();
+    return (const CJHSearchNode *)node;
+}
+
 void CKeyIndex::dumpNode(FILE *out, offset_t pos, unsigned count, bool isRaw)
 {
     CLoadNodeCacheState readState;
@@ -1816,6 +1917,24 @@ void CKeyIndex::ensureBloomFiltersLoaded(const INodeLoader & nodeLoader) const
     const_cast<CKeyIndex *>(this)->loadBloomFilters(nodeLoader);
 }
 
+void CKeyIndex::loadDictionary(const INodeLoader & nodeLoader)
+{
+    //The dictionary is needed to expand any of the leaves, so it is loaded once when the index is opened
+    offset_t dictionaryAddr = keyHdr->queryDictionaryHead();
+    if (!dictionaryAddr)
+        return;
+
+    StringBuffer dictionary;
+    while (dictionaryAddr)
+    {
+        Owned<const CJHTreeNode> node = nodeLoader.loadNode(nullptr, dictionaryAddr);
+        assertex(node->isMetadata());
+        static_cast<const CJHTreeMetadataNode *>(node.get())->get(dictionary);
+        dictionaryAddr = node->getRightSib();
+    }
+    keyHdr->setDictionary(createZStdDictionary(dictionary.length(), dictionary.str()));
+}
+
 void CKeyIndex::loadBloomFilters(const INodeLoader & nodeLoader)
 {
     offset_t bloomAddr = keyHdr->getHdrStruct()->bloomHead;
@@ -2181,6 +2300,7 @@ CKeyCursor::CKeyCursor(const CKeyCursor &from)
     fullBufferValid = false;
     eof = from.eof;
     matched = from.matched;
+    activePayload.projection = from.activePayload.projection;
 }
 
 
@@ -2290,6 +2410,12 @@ const byte *CKeyCursor::queryKeyedBuffer() const
     return (const byte *) recordBuffer;
 }
 
+void CKeyCursor::setPayloadProjection(const PayloadProjection * projection)
+{
+    activePayload.projection = projection;
+    fullBufferValid = false;
+}
+
 size32_t CKeyCursor::getSize()
 {
     assertex(node);
@@ -3114,7 +3240,16 @@ class CLazyKeyIndex final : implements IKeyIndex, public CInterface
         CriticalBlock b(c);
         if (!realKey)
         {
-            Owned<IMemoryMappedFile> mapped = useMemoryMappedIndexes ? delayedFile->getMappedFile() : nullptr;
+            Owned<IMemoryMappedFile> mapped;
+            if (useMemoryMappedIndexes)
+                mapped.setown(delayedFile->getMappedFile());
+            else if (residentIndexMaxSize)
+            {
+                Owned<IFileIO> fileIO = delayedFile->getFileIO();
+                offset_t size = fileIO ? fileIO->size() : 0;
+                if (size && (size <= residentIndexMaxSize))
+                    mapped.setown(delayedFile->getMappedFile());
+            }
             if (mapped)
                 realKey.setown(queryKeyStore()->load(keyfile, crc, mapped, isTLK, blockedIOSize));
             else
@@ -3240,6 +3375,11 @@ extern jhtree_decl size_t setBlobCacheMem(size_t cacheSize)
     return queryNodeCache()->setBlobCacheMem(cacheSize);
 }
 
+extern jhtree_decl __uint64 queryNodeCacheStatistic(NodeType type, StatisticKind kind)
+{
+    return queryNodeCache()->getStatisticValue(type, kind);
+}
+
 void setNodeFetchThresholdNs(__uint64 thresholdNs)
 {
     fetchThresholdCycles = nanosec_to_cycle(thresholdNs);
@@ -3752,6 +3892,13 @@ public:
         CKeyLevelManager::setLayoutTranslator(trans);
     }
 
+    virtual void setPayloadProjection(const RtlRecord * projected) override
+    {
+        CKeyLevelManager::setPayloadProjection(projected);
+        ForEachItemIn(i, cursorArray)
+            cursorArray.item(i).setPayloadProjection(projection.get());
+    }
+
     virtual void clearKey() override
     {
         keyset.clear();
@@ -3774,6 +3921,8 @@ public:
             }
             if (sortFieldOffset > keyedSize)
                 throw MakeStringException(0, "Index sort order can only include keyed fields");
+            indexFormat = &actualRecInfo;
+            updatePayloadProjection();
         }
         else
             numkeys = 0;
@@ -3788,6 +3937,7 @@ public:
         for (i = 0; i < numkeys; i++)
         {
             Owned<IKeyCursor> cursor = keyset->queryPart(i)->getCursor(filter, logExcessiveSeeks);
+            cursor->setPayloadProjection(projection.get());
             cursor->reset(ctx);
             for (;;)
             {
@@ -3995,6 +4145,7 @@ public:
             mb.read(keyno);
             keyNoArray.append(keyno);
             keyCursor = keyset->queryPart(keyno)->getCursor(filter, logExcessiveSeeks);
+            keyCursor->setPayloadProjection(projection.get());
             keyCursor->deserializeCursorPos(mb, ctx);
             cursorArray.append(*keyCursor);
             mergeHeapArray.append(i);
@@ -4162,8 +4313,14 @@ class IKeyManagerSlowTest : public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE( IKeyManagerSlowTest  );
         CPPUNIT_TEST(testStepping);
         CPPUNIT_TEST(testKeys);
+        CPPUNIT_TEST(testParallelSerialize);
+        CPPUNIT_TEST(testColumnar);
+        CPPUNIT_TEST(testDictionary);
+        CPPUNIT_TEST(testResident);
     CPPUNIT_TEST_SUITE_END();
 
+    bool parallelSerialize = false;
+
     void testStepping()
     {
         buildTestKeys(false, true, false, false, nullptr, nullptr);
@@ -4299,6 +4456,7 @@ class IKeyManagerSlowTest : public CppUnit::TestFixture
                 (noSeek ? TRAILING_HEADER_ONLY : 0U) |
                 0U,
                 maxRecSize, NODESIZE, keyedSize, &helper);
+        options.parallelSerialize = parallelSerialize;
         Owned<IKeyBuilder> builder = createKeyBuilder(out, options);
 
         char keybuf[18];
@@ -4347,6 +4505,23 @@ class IKeyManagerSlowTest : public CppUnit::TestFixture
         DBGLOG("Size %s=%llu", filename, file->size());
     }
 
+    void readTestKey(const char *filename, MemoryBuffer &contents)
+    {
+        OwnedIFile file = createIFile(filename);
+        OwnedIFileIO io = file->open(IFOread);
+        read(io, 0, (size32_t)file->size(), contents);
+    }
+
+    void checkSameTestKeys(const char *filename1, const char *filename2)
+    {
+        MemoryBuffer contents1, contents2;
+        readTestKey(filename1, contents1);
+        readTestKey(filename2, contents2);
+        ASSERT(contents1.length() != 0);
+        ASSERT(contents1.length() == contents2.length());
+        ASSERT(memcmp(contents1.toByteArray(), contents2.toByteArray(), contents1.length()) == 0);
+    }
+
     void removeTestKeys()
     {
         ASSERT(remove("keyfile1.$$$")==0);
@@ -4371,7 +4546,7 @@ class IKeyManagerSlowTest : public CppUnit::TestFixture
         key->releaseBlobs();
     }
 protected:
-    void testKeys(bool variable, bool useTrailingHeader, bool noSeek, bool quickCompressed, const char * compression)
+    IOutputMetaData *createTestMeta(bool variable)
     {
         const char *json = variable ?
                 "{ \"ty1\": { \"fieldType\": 4, \"length\": 10 }, "
@@ -4389,7 +4564,12 @@ protected:
                 " { \"name\": \"f1\", \"type\": \"ty1\", \"flags\": 4 }, "
                 " ] "
                 "}";
-        Owned<IOutputMetaData> meta = createTypeInfoOutputMetaData(json, false);
+        return createTypeInfoOutputMetaData(json, false);
+    }
+
+    void testKeys(bool variable, bool useTrailingHeader, bool noSeek, bool quickCompressed, const char * compression)
+    {
+        Owned<IOutputMetaData> meta = createTestMeta(variable);
         const RtlRecord &recInfo = meta->queryRecordAccessor(true);
         buildTestKeys(variable, useTrailingHeader, noSeek, quickCompressed, meta, compression);
         {
@@ -4571,6 +4751,287 @@ protected:
             CPPUNIT_ASSERT_MESSAGE(s.str(), false);
         }
     }
+
+    void testParallelSerialize()
+    {
+        //Serializing the nodes in parallel must generate exactly the same file as a serial build
+        try
+        {
+            for (bool var : { true, false })
+                for (bool noseek : { false, true })
+                    for (bool quick : { true, false })
+                        for (const char * compression : { (const char *)nullptr, "inplace", "hybrid", "hybrid:blob(lz4)" })
+                        {
+                            Owned<IOutputMetaData> meta = createTestMeta(var);
+                            parallelSerialize = false;
+                            buildTestKey("keyfile1.$$$", false, var, true, noseek, quick, meta, compression);
+                            parallelSerialize = true;
+                            buildTestKey("keyfile2.$$$", false, var, true, noseek, quick, meta, compression);
+                            parallelSerialize = false;
+                            checkSameTestKeys("keyfile1.$$$", "keyfile2.$$$");
+                            removeTestKeys();
+                        }
+
+            //Columnar leaves are only generated for fixed size rows with a payload
+            Owned<IOutputMetaData> meta = createColumnarMeta(false);
+            parallelSerialize = false;
+            buildColumnarKey("keyfile1.$$$", meta);
+            parallelSerialize = true;
+            buildColumnarKey("keyfile2.$$$", meta);
+            parallelSerialize = false;
+            checkSameTestKeys("keyfile1.$$$", "keyfile2.$$$");
+            removeTestKeys();
+        }
+        catch (IException * e)
+        {
+            StringBuffer s;
+            e->errorMessage(s);
+            CPPUNIT_ASSERT_MESSAGE(s.str(), false);
+        }
+    }
+
+    void testResident()
+    {
+        //Memory mapped indexes must return the same rows whether or not their nodes are kept resident
+        try
+        {
+            for (const char * compression : { (const char *)nullptr, "inplace" })
+            {
+                Owned<IOutputMetaData> meta = createTestMeta(false);
+                const RtlRecord &recInfo = meta->queryRecordAccessor(true);
+                buildTestKey("keyfile1.$$$", false, false, false, false, true, meta, compression);
+                for (bool resident : { false, true })
+                {
+                    residentIndexMaxSize = resident ? 0x10000000 : 0;
+                    OwnedIFile file = createIFile("keyfile1.$$$");
+                    Owned<IMemoryMappedFile> mapped = file->openMemoryMapped();
+                    //Use a different crc for each mode so the key store does not return the index from the previous iteration
+                    Owned<IKeyIndex> index = queryKeyStore()->load("keyfile1.$$$", resident ? 1 : 0, mapped, false, 0);
+                    Owned<IKeyManager> tlk = createLocalKeyManager(recInfo, index, nullptr, false, false);
+                    Owned<IStringSet> sset = createStringSet(10);
+                    sset->addRange("0000000001", "0000000100");
+                    tlk->append(createKeySegmentMonitor(false, sset.getClear(), 0, 0, 10));
+                    tlk->finishSegmentMonitors();
+                    //The second pass finds the nodes that were loaded by the first
+                    for (unsigned pass = 0; pass < 2; pass++)
+                    {
+                        tlk->reset();
+                        unsigned count = 0;
+                        while (tlk->lookup(true))
+                            count++;
+                        ASSERT_EQUAL(76U, count);
+                    }
+                    tlk->releaseSegmentMonitors();
+                }
+                residentIndexMaxSize = 0;
+                clearKeyStoreCache(true);
+                removeTestKeys();
+            }
+        }
+        catch (IException * e)
+        {
+            residentIndexMaxSize = 0;
+            StringBuffer s;
+            e->errorMessage(s);
+            CPPUNIT_ASSERT_MESSAGE(s.str(), false);
+        }
+    }
+
+    IOutputMetaData *createColumnarMeta(bool projected, bool retyped = false)
+    {
+        //If retyped the projected f3 is an integer rather than a string, so it cannot be matched by name alone
+        const char *json = projected ?
+                retyped ?
+                "{ \"ty1\": { \"fieldType\": 4, \"length\": 10 }, "
+                "  \"ty2\": { \"fieldType\": 1, \"length\": 4 }, "
+                " \"fieldType\": 13, \"length\": 14, "
+                " \"fields\": [ "
+                " { \"name\": \"f1\", \"type\": \"ty1\", \"flags\": 4 }, "
+                " { \"name\": \"f3\", \"type\": \"ty2\", \"flags\": 65540 } "
+                " ] "
+                "}"
+                :
+                "{ \"ty1\": { \"fieldType\": 4, \"length\": 10 }, "
+                "  \"ty2\": { \"fieldType\": 4, \"length\": 4 }, "
+                " \"fieldType\": 13, \"length\": 14, "
+                " \"fields\": [ "
+                " { \"name\": \"f1\", \"type\": \"ty1\", \"flags\": 4 }, "
+                " { \"name\": \"f3\", \"type\": \"ty2\", \"flags\": 65540 } "   // 0x010004 i.e. payload
+                " ] "
+                "}"
+                :
+                "{ \"ty1\": { \"fieldType\": 4, \"length\": 10 }, "
+                "  \"ty2\": { \"fieldType\": 4, \"length\": 4 }, "
+                " \"fieldType\": 13, \"length\": 18, "
+                " \"fields\": [ "
+                " { \"name\": \"f1\", \"type\": \"ty1\", \"flags\": 4 }, "
+                " { \"name\": \"f2\", \"type\": \"ty2\", \"flags\": 65540 }, "
+                " { \"name\": \"f3\", \"type\": \"ty2\", \"flags\": 65540 } "
+                " ] "
+                "}";
+        return createTypeInfoOutputMetaData(json, false);
+    }
+
+    static constexpr unsigned numColumnarRows = 10000;
+
+    void buildColumnarKey(const char *filename, IOutputMetaData * meta)
+    {
+        TestIndexWriteArg helper(filename, "hybrid:columnar", meta);
+        OwnedIFile file = createIFile(filename);
+        OwnedIFileIO io = file->openShared(IFOcreate, IFSHfull);
+        Owned<IFileIOStream> out = createIOStream(io);
+        KeyBuilderOptions options(COL_PREFIX | HTREE_FULLSORT_KEY | HTREE_COMPRESSED_KEY | USE_TRAILING_HEADER, 18, NODESIZE, 10, &helper);
+        options.parallelSerialize = parallelSerialize;
+        Owned<IKeyBuilder> builder = createKeyBuilder(out, options);
+        char row[19];
+        for (unsigned count = 0; count < numColumnarRows; count++)
+        {
+            snprintf(row, sizeof(row), "%010u%04u%04u", count, count % 7, (count * 13) % 10000);
+            builder->processKeyData(row, count, 18);
+        }
+        builder->finish(nullptr, nullptr, 18, nullptr);
+        out->flush();
+    }
+
+    void testColumnar()
+    {
+        try
+        {
+            constexpr unsigned numRows = numColumnarRows;
+            Owned<IOutputMetaData> meta = createColumnarMeta(false);
+            Owned<IOutputMetaData> projectedMeta = createColumnarMeta(true);
+            Owned<IOutputMetaData> retypedMeta = createColumnarMeta(true, true);
+            const RtlRecord &recInfo = meta->queryRecordAccessor(true);
+            buildColumnarKey("keyfile1.$$$", meta);
+
+            //Check that all the payload columns are fetched when there is no projection, or the projected field has a
+            //different type, and otherwise that only the projected ones are fetched and the others are zero filled.
+            Owned<IKeyIndex> index = createKeyIndex("keyfile1.$$$", 0, false, 0);
+            static const char zeros[4] = { 0, 0, 0, 0 };
+            for (unsigned mode = 0; mode < 3; mode++)
+            {
+                bool project = (mode == 1);
+                Owned<IKeyManager> tlk = createLocalKeyManager(recInfo, index, nullptr, false, false);
+                if (mode == 1)
+                    tlk->setPayloadProjection(&projectedMeta->queryRecordAccessor(true));
+                else if (mode == 2)
+                    tlk->setPayloadProjection(&retypedMeta->queryRecordAccessor(true));
+                tlk->finishSegmentMonitors();
+                tlk->reset();
+                char expected[19];
+                unsigned count = 0;
+                while (tlk->lookup(true))
+                {
+                    snprintf(expected, sizeof(expected), "%010u%04u%04u", count, count % 7, (count * 13) % 10000);
+                    const char * row = (const char *)tlk->queryKeyBuffer();
+                    ASSERT(memcmp(row, expected, 10) == 0);
+                    if (project)
+                        ASSERT(memcmp(row + 10, zeros, 4) == 0);
+                    else
+                        ASSERT(memcmp(row + 10, expected + 10, 4) == 0);
+                    ASSERT(memcmp(row + 14, expected + 14, 4) == 0);
+                    count++;
+                }
+                ASSERT(count == numRows);
+            }
+            index.clear();
+            clearKeyStoreCache(true);
+            ASSERT(remove("keyfile1.$$$")==0);
+        }
+        catch (IException * e)
+        {
+            StringBuffer s;
+            e->errorMessage(s);
+            CPPUNIT_ASSERT_MESSAGE(s.str(), false);
+        }
+    }
+
+    void makeDictionaryRow(char * row, unsigned count)
+    {
+        //Payloads built from a small vocabulary, so that there is common content for the dictionary to learn
+        static const char * const words[] = { "alpha ", "bravo ", "charlie ", "delta ", "echo ", "foxtrot ", "golf ", "hotel " };
+        snprintf(row, 11, "%010u", count);
+        unsigned offset = 10;
+        unsigned seed = count;
+        while (offset < 64)
+        {
+            const char * word = words[seed % 8];
+            seed = seed * 1103515245 + 12345;
+            size32_t len = std::min((size32_t)strlen(word), 64 - offset);
+            memcpy(row + offset, word, len);
+            offset += len;
+        }
+    }
+
+    void testDictionary()
+    {
+        //Build an index whose leaves are compressed with a trained dictionary, and check every row reads back
+        try
+        {
+            constexpr unsigned numRows = 20000;
+            const char *json =
+                    "{ \"ty1\": { \"fieldType\": 4, \"length\": 10 }, "
+                    "  \"ty2\": { \"fieldType\": 4, \"length\": 54 }, "
+                    " \"fieldType\": 13, \"length\": 64, "
+                    " \"fields\": [ "
+                    " { \"name\": \"f1\", \"type\": \"ty1\", \"flags\": 4 }, "
+                    " { \"name\": \"f2\", \"type\": \"ty2\", \"flags\": 65540 } "
+                    " ] "
+                    "}";
+            Owned<IOutputMetaData> meta = createTypeInfoOutputMetaData(json, false);
+            const RtlRecord &recInfo = meta->queryRecordAccessor(true);
+            char row[64];
+            {
+                TestIndexWriteArg helper("keyfile1.$$$", "hybrid:dictionary(16Ki)", meta);
+                OwnedIFile file = createIFile("keyfile1.$$$");
+                OwnedIFileIO io = file->openShared(IFOcreate, IFSHfull);
+                Owned<IFileIOStream> out = createIOStream(io);
+                KeyBuilderOptions options(COL_PREFIX | HTREE_FULLSORT_KEY | HTREE_COMPRESSED_KEY, 64, NODESIZE, 10, &helper);
+                Owned<IKeyBuilder> builder = createKeyBuilder(out, options);
+                for (unsigned count = 0; count < numRows; count++)
+                {
+                    makeDictionaryRow(row, count);
+                    builder->processKeyData(row, count, 64);
+                }
+                builder->finish(nullptr, nullptr, 64, nullptr);
+                out->flush();
+            }
+
+            //The header is at the start of the file, check a dictionary was stored
+            MemoryBuffer contents;
+            readTestKey("keyfile1.$$$", contents);
+            ASSERT(contents.length() > sizeof(KeyHdr));
+            KeyHdr hdr;
+            memcpy(&hdr, contents.toByteArray(), sizeof(hdr));
+            ASSERT(hdr.dictionaryHead != 0 && hdr.dictionaryHead != -1);
+
+            //Read everything back twice, so that the per-thread expander is reused across the leaves
+            Owned<IKeyIndex> index = createKeyIndex("keyfile1.$$$", 0, false, 0);
+            for (unsigned pass = 0; pass < 2; pass++)
+            {
+                Owned<IKeyManager> tlk = createLocalKeyManager(recInfo, index, nullptr, false, false);
+                tlk->finishSegmentMonitors();
+                tlk->reset();
+                unsigned count = 0;
+                while (tlk->lookup(true))
+                {
+                    makeDictionaryRow(row, count);
+                    ASSERT(memcmp(tlk->queryKeyBuffer(), row, 64) == 0);
+                    count++;
+                }
+                ASSERT(count == numRows);
+            }
+            index.clear();
+            clearKeyStoreCache(true);
+            ASSERT(remove("keyfile1.$$$")==0);
+        }
+        catch (IException * e)
+        {
+            StringBuffer s;
+            e->errorMessage(s);
+            CPPUNIT_ASSERT_MESSAGE(s.str(), false);
+        }
+    }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION( IKeyManagerSlowTest );
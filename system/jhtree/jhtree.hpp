@@ -32,6 +32,7 @@
 enum NodeType : byte;
 
 class BloomFilter;
+class PayloadProjection;
 interface IIndexFilterList;
 interface IPropertyTree;
 
@@ -65,6 +66,7 @@ interface jhtree_decl IKeyCursor : public IInterface
     virtual const byte *queryRecordBuffer() const = 0;
     virtual const byte *queryKeyedBuffer() const = 0;
     virtual void mergeStats(CRuntimeStatisticCollection & stats) const = 0;
+    virtual void setPayloadProjection(const PayloadProjection * projection) = 0;   // Only the projected payload fields are guaranteed to be fetched
 };
 
 interface IKeyIndex;
@@ -149,6 +151,8 @@ extern jhtree_decl void logCacheState();
 extern jhtree_decl size_t setNodeCacheMem(size_t cacheSize);
 extern jhtree_decl size_t setLeafCacheMem(size_t cacheSize);
 extern jhtree_decl size_t setBlobCacheMem(size_t cacheSize);
+// Returns StNumCacheHits/StNumCacheAdds/StNumCacheDuplicates/StNumCacheEvictions for the cache that holds nodes of the given type
+extern jhtree_decl __uint64 queryNodeCacheStatistic(NodeType type, StatisticKind kind);
 extern jhtree_decl void setNodeFetchThresholdNs(__uint64 thresholdNs);
 extern jhtree_decl void setIndexWarningThresholds(IPropertyTree * options);
 
@@ -175,6 +179,7 @@ extern std::atomic<unsigned __int64> leafSearchCycles;
 extern jhtree_decl bool linuxYield;
 extern jhtree_decl bool flushJHtreeCacheOnOOM;
 extern jhtree_decl bool useMemoryMappedIndexes;
+extern jhtree_decl offset_t residentIndexMaxSize;   // Memory map indexes up to this size, and keep all their nodes loaded outside the node cache
 extern jhtree_decl void logNodeCacheStats(const char *prefix);
 
 
@@ -268,6 +273,7 @@ interface IKeyManager : public IInterface, extends IIndexReadContext
     virtual void releaseBlobs() = 0;
 
     virtual void setLayoutTranslator(const IDynamicTransform * trans) = 0;
+    virtual void setPayloadProjection(const RtlRecord * projected) = 0;    // Payload fields missing from projected may be returned as zeros
     virtual void finishSegmentMonitors() = 0;
     virtual void describeFilter(StringBuffer &out) const = 0;
 
@@ -98,6 +98,8 @@ protected:
     CKeyHdr *keyHdr;
     CNodeCache *cache;
     const CJHSearchNode *rootNode;
+    std::unique_ptr<std::atomic<const CJHTreeNode *>[]> residentNodes; // Indexed by offset/nodeSize.  Only used for small memory mapped indexes
+    offset_t numResidentNodes = 0;
     mutable RelaxedAtomic<unsigned> keySeeks;
     mutable RelaxedAtomic<unsigned> keyScans;
     mutable offset_t latestGetNodeOffset;  // NOT SAFE but only used by keydiff
@@ -105,12 +107,14 @@ protected:
     CJHTreeNode *loadNodeFromMemory(const void *nodeData, offset_t pos, bool needsCopy) const;
     CJHTreeNode *_createNode(const NodeHdr &hdr) const;
     const CJHSearchNode *getIndexNodeUsingLoader(const INodeLoader &nodeLoader, offset_t offset, NodeType type, IContextLogger *ctx) const;
+    const CJHSearchNode *getResidentNode(const INodeLoader &nodeLoader, offset_t offset) const;
     const CJHBlobNode *getBlobNode(const INodeLoader &nodeLoader, offset_t nodepos, IContextLogger *ctx);
 
     CKeyIndex(unsigned _iD, const char *_name, bool _forceTLK);
     ~CKeyIndex();
     void init(KeyHdr &hdr, const INodeLoader & nodeLoader);
     void loadBloomFilters(const INodeLoader & nodeLoader);
+    void loadDictionary(const INodeLoader & nodeLoader);
     void ensureBloomFiltersLoaded(const INodeLoader & nodeLoader) const;
 
     const CJHSearchNode *getRootNode(const INodeLoader & nodeLoader) const;
@@ -212,6 +216,9 @@ public:
 // INodeLoader impl.
     virtual const CJHTreeNode *loadNode(cycle_t * fetchCycles, offset_t offset, CLoadNodeCacheState & readState) const override;
     virtual void mergeStats(CRuntimeStatisticCollection & stats) const override {}
+
+protected:
+    void makeResident();
 };
 
 class jhtree_decl CDiskKeyIndex : public CKeyIndex
@@ -275,6 +282,7 @@ public:
     virtual bool nextRange(unsigned groupSegCount) override;
     virtual const byte *queryRecordBuffer() const override;
     virtual const byte *queryKeyedBuffer() const override;
+    virtual void setPayloadProjection(const PayloadProjection * projection) override;
 
  // INodeLoader impl.
     virtual const CJHTreeNode *loadNode(cycle_t * fetchCycles, offset_t offset) const override
@@ -19,6 +19,7 @@
 #include "eclhelper.hpp"
 #include "bloom.hpp"
 #include "jmisc.hpp"
+#include "jtask.hpp"
 #include "jhinplace.hpp"
 #include "jhblockcompressed.hpp"
 
@@ -101,6 +102,14 @@ class PocIndexCompressor : public CInterfaceOf<IIndexCompressor>
     {
         return 0;
     }
+    virtual size32_t queryDictionaryTrainingSize() const override
+    {
+        return 0;
+    }
+    virtual IZStdDictionary * trainDictionary(unsigned numSamples, const size_t * sampleSizes, const void * samples) override
+    {
+        throwUnexpected();
+    }
 };
 
 class LegacyIndexCompressor : public CInterfaceOf<IIndexCompressor>
@@ -128,6 +137,14 @@ class LegacyIndexCompressor : public CInterfaceOf<IIndexCompressor>
     {
         return 0; // MORE: Update for in-place row compression
     }
+    virtual size32_t queryDictionaryTrainingSize() const override
+    {
+        return 0;
+    }
+    virtual IZStdDictionary * trainDictionary(unsigned numSamples, const size_t * sampleSizes, const void * samples) override
+    {
+        throwUnexpected();
+    }
 };
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -138,8 +155,86 @@ KeyBuilderOptions::KeyBuilderOptions(unsigned _flags, unsigned _rawSize, unsigne
 }
 
 
+// A node whose serialized image is generated on a worker thread, while the images are still written to the file
+// in order.  Only the work done by the node's write() moves off the building thread - e.g., serializing the
+// inplace keyed trie.  The payload compression happens as rows are added (the compressed size decides when a
+// node is full), so it is still serial.
+class CSerializedNode : public CInterfaceOf<IFileIOStream>, implements IWritableNode
+{
+public:
+    CSerializedNode(CWriteNodeBase &_node) : node(&_node), fpos(_node.getFpos()) {}
+
+    void serialize()
+    {
+        node->write(this, nullptr);
+        memorySize = node->getMemorySize();
+        node.clear();
+    }
+
+// IWritableNode
+    virtual void write(IFileIOStream *out, CRC32 *crc) override
+    {
+        out->seek(fpos, IFSbegin);
+        out->write(image.length(), image.toByteArray());
+        if (crc)
+            crc->tally(image.length(), image.toByteArray());
+    }
+    virtual size32_t getMemorySize() const override { return memorySize; }
+    offset_t getFpos() const { return fpos; }
+
+// IFileIOStream - only used to capture the output of the node's write()
+    virtual size32_t read(size32_t len, void * data) override { throwUnexpected(); }
+    virtual void flush() override {}
+    virtual size32_t write(size32_t len, const void * data) override
+    {
+        image.append(len, data);
+        return len;
+    }
+    virtual void seek(offset_t pos, IFSmode origin) override { assertex((origin == IFSbegin) && (pos == fpos)); }
+    virtual offset_t size() override { return image.length(); }
+    virtual offset_t tell() override { return fpos + image.length(); }
+    virtual unsigned __int64 getStatistic(StatisticKind kind) override { return 0; }
+    virtual void close() override {}
+
+private:
+    Linked<CWriteNodeBase> node;
+    MemoryBuffer image;
+    offset_t fpos;
+    size32_t memorySize = 0;
+};
+
+class CSerializeBatch : public CInterface
+{
+public:
+    CSerializeBatch() : completed(new CCompletionTask(queryTaskScheduler())) {}
+
+    void add(CWriteNodeBase &node)
+    {
+        CSerializedNode *serialized = new CSerializedNode(node);
+        nodes.append(*serialized);
+        Linked<CSerializedNode> task(serialized);
+        completed->spawn([task]() { task->serialize(); });
+    }
+    void wait()
+    {
+        if (!waited)
+        {
+            waited = true;
+            completed->decAndWait();
+        }
+    }
+
+public:
+    IArrayOf<CSerializedNode> nodes;
+private:
+    Owned<CCompletionTask> completed;
+    bool waited = false;
+};
+
 class CKeyBuilder : public CInterfaceOf<IKeyBuilder>
 {
+    static constexpr unsigned serializeBatchSize = 64;
+
 protected:
     unsigned keyValueSize;
     count_t records;
@@ -178,6 +273,14 @@ private:
     Owned<IIndexCompressor> indexCompressor;
     bool enforceOrder = true;
     bool isTLK = false;
+    bool parallelSerialize = false;
+    Owned<CSerializeBatch> activeBatch;     // nodes being serialized on the task scheduler
+    Owned<CSerializeBatch> completingBatch; // previous batch - written once it has been serialized
+    size32_t dictionaryTrainingSize = 0;    // non-zero while the leading rows are sampled to train the leaf dictionary
+    MemoryBuffer trainingRows;
+    std::vector<size_t> trainingRowSizes;
+    std::vector<offset_t> trainingRowPositions;
+    Owned<IZStdDictionary> dictionary;
 
     void appendPendingNode(CWriteNodeBase &node)
     {
@@ -208,7 +311,7 @@ private:
 
 public:
     CKeyBuilder(IFileIOStream *_out, const KeyBuilderOptions &options)
-        : out(_out), enforceOrder(options.enforceOrder), isTLK(options.isTLK)
+        : out(_out), enforceOrder(options.enforceOrder), isTLK(options.isTLK), parallelSerialize(options.parallelSerialize)
     {
         sequence = options.startSequence;
         keyHdr.setown(new CWriteKeyHdr());
@@ -280,13 +383,17 @@ public:
             }
         }
 
+        bool isInplace = false;
         if (!isEmptyString(compression))
         {
             hdr->version = 2;    // Old builds will give a reasonable error message
             if (strieq(compression, "POC") || startsWithIgnoreCase(compression, "POC:"))
                 indexCompressor.setown(new PocIndexCompressor);
             else if (strieq(compression, "inplace") || startsWithIgnoreCase(compression, "inplace:"))
+            {
                 indexCompressor.setown(new InplaceIndexCompressor(keyedSize, keyHdr, options.helper, compression));
+                isInplace = true;
+            }
             else if (strieq(compression, "hybrid") || startsWithIgnoreCase(compression, "hybrid:"))
                 indexCompressor.setown(new HybridIndexCompressor(keyedSize, keyHdr, options.helper, compression, isTLK));
             else if (strieq(compression, "legacy"))
@@ -299,12 +406,20 @@ public:
         }
         else
             indexCompressor.setown(new LegacyIndexCompressor);
+        // Only the inplace nodes do enough work in write() to be worth serializing on another thread - the other
+        // formats compress as rows are added, and their write() is little more than a copy.
+        if (!isInplace)
+            parallelSerialize = false;
+        dictionaryTrainingSize = indexCompressor->queryDictionaryTrainingSize();
 
         keyHdr->write(out, &headCRC);  // Reserve space for the header - we may seek back and write it properly later
     }
     
     ~CKeyBuilder()
     {
+        // If the build was abandoned, ensure no tasks are still referencing the nodes
+        abandonBatch(completingBatch);
+        abandonBatch(activeBatch);
         for (;;)
         {
             CRC32HTE *et = (CRC32HTE *)crcEndPosTable.next(NULL);
@@ -440,6 +555,63 @@ protected:
             maxNodeMemorySize = memorySize;
     }
 
+    // Write a node that has been completed while the leaves and blobs are being added.  If parallel serialization
+    // is enabled the nodes are serialized in batches, and each batch is written in order while the next one is
+    // being serialized.
+    void outputNode(CWriteNodeBase &node)
+    {
+        if (!parallelSerialize)
+        {
+            writeNode(&node, node.getFpos());
+            return;
+        }
+        if (!activeBatch)
+            activeBatch.setown(new CSerializeBatch);
+        activeBatch->add(node);
+        if (activeBatch->nodes.ordinality() >= serializeBatchSize)
+        {
+            writeBatch(completingBatch);
+            completingBatch.setown(activeBatch.getClear());
+        }
+    }
+
+    void writeBatch(Owned<CSerializeBatch> &batch)
+    {
+        if (batch)
+        {
+            batch->wait();
+            ForEachItemIn(idx, batch->nodes)
+            {
+                CSerializedNode &serialized = batch->nodes.item(idx);
+                writeNode(&serialized, serialized.getFpos());
+            }
+            batch.clear();
+        }
+    }
+
+    void flushSerializedNodes()
+    {
+        writeBatch(completingBatch);
+        writeBatch(activeBatch);
+        parallelSerialize = false;
+    }
+
+    void abandonBatch(Owned<CSerializeBatch> &batch)
+    {
+        if (batch)
+        {
+            try
+            {
+                batch->wait();
+            }
+            catch (IException *e)
+            {
+                e->Release();
+            }
+            batch.clear();
+        }
+    }
+
     void flushNode(CWriteNode *node, NodeInfoArray &nodeInfo)
     {   
         if (node)
@@ -453,7 +625,7 @@ protected:
                 CWriteNodeBase &pending = pendingNodes.item(0);
                 if (!prevLeafNode || pending.getFpos() > prevLeafNode->getFpos())
                     break;
-                writeNode(&pending, pending.getFpos());
+                outputNode(pending);
                 pendingNodes.remove(0);
             }
         }
@@ -472,7 +644,7 @@ protected:
             }
             else
             {
-                writeNode(prevLeafNode, prevLeafNode->getFpos());
+                outputNode(*prevLeafNode);
                 prevLeafNode->Release();
             }
             prevLeafNode = NULL;
@@ -512,6 +684,8 @@ protected:
     {
         if (maxRecordSizeSeen)
             keyHdr->setMaxKeyLength(maxRecordSizeSeen);
+        if (dictionaryTrainingSize)
+            trainDictionary();
         if (activeBlobNode && (keyHdr->getKeyType() & TRAILING_HEADER_ONLY))
         {
             appendPendingNode(*activeBlobNode);
@@ -525,7 +699,7 @@ protected:
         }
         if (activeBlobNode)
         {
-            writeNode(activeBlobNode, activeBlobNode->getFpos());
+            outputNode(*activeBlobNode);
             activeBlobNode->Release();
             activeBlobNode = nullptr;
         }
@@ -535,10 +709,11 @@ protected:
             ForEachItemIn(idx, pendingNodes)
             {
                 CWriteNodeBase &pending = pendingNodes.item(idx);
-                writeNode(&pending, pending.getFpos());
+                outputNode(pending);
             }
             pendingNodes.kill();
         }
+        flushSerializedNodes();
         offsetBranches = nextPos;
         buildTree(leafInfo);
         offsetRoot = keyHdr->getHdrStruct()->root;
@@ -549,6 +724,8 @@ protected:
             toXML(metadata, metaXML);
             writeMetadata(metaXML.str(), metaXML.length());
         }
+        if (dictionary)
+            keyHdr->getHdrStruct()->dictionaryHead = writeRawDataNodes((const char *)dictionary->queryData(), dictionary->querySize());
 
         //Avoid creating any bloom filters if we only have single leaf node of search entries...
         if (levels > 0)
@@ -599,6 +776,39 @@ protected:
     }
 
     virtual void processKeyData(const char *keyData, offset_t pos, size32_t recsize) override
+    {
+        if (dictionaryTrainingSize)
+        {
+            //No leaves can be created until the dictionary has been trained, so buffer the leading rows
+            trainingRows.append(recsize, keyData);
+            trainingRowSizes.push_back(recsize);
+            trainingRowPositions.push_back(pos);
+            if (trainingRows.length() >= dictionaryTrainingSize)
+                trainDictionary();
+            return;
+        }
+        addKeyData(keyData, pos, recsize);
+    }
+
+    void trainDictionary()
+    {
+        dictionaryTrainingSize = 0;
+        unsigned numRows = (unsigned)trainingRowSizes.size();
+        if (numRows)
+            dictionary.setown(indexCompressor->trainDictionary(numRows, trainingRowSizes.data(), trainingRows.toByteArray()));
+
+        const char * row = trainingRows.toByteArray();
+        for (unsigned i = 0; i < numRows; i++)
+        {
+            addKeyData(row, trainingRowPositions[i], (size32_t)trainingRowSizes[i]);
+            row += trainingRowSizes[i];
+        }
+        trainingRows.resetBuffer();
+        std::vector<size_t>().swap(trainingRowSizes);
+        std::vector<offset_t>().swap(trainingRowPositions);
+    }
+
+    void addKeyData(const char *keyData, offset_t pos, size32_t recsize)
     {
         records++;
         if (NULL == activeNode)
@@ -662,8 +872,8 @@ protected:
             }
             else
             {
-                writeNode(prevBlobNode, prevBlobNode->getFpos());
-                delete(prevBlobNode);
+                outputNode(*prevBlobNode);
+                prevBlobNode->Release();
             }
         }
     }
@@ -720,8 +930,14 @@ protected:
     void writeMetadata(char const * data, size32_t size)
     {
         assertex(keyHdr->getHdrStruct()->metadataHead == 0);
+        keyHdr->getHdrStruct()->metadataHead = writeRawDataNodes(data, size);
+    }
+
+    // Write a chain of raw data nodes, returning the position of the first
+    offset_t writeRawDataNodes(char const * data, size32_t size)
+    {
         assertex(size);
-        keyHdr->getHdrStruct()->metadataHead = nextPos;
+        offset_t head = nextPos;
         Owned<CMetadataWriteNode> prevNode;
         while(size)
         {
@@ -738,6 +954,7 @@ protected:
             prevNode.setown(node.getClear());
         }
         writeNode(prevNode, prevNode->getFpos());
+        return head;
     }
 
     void writeBloomFilter(const BloomFilter &filter)
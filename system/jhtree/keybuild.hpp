@@ -116,6 +116,7 @@ public:
     StringBuffer compression;
     bool enforceOrder = true;
     bool isTLK = false;
+    bool parallelSerialize = false; // serialize completed inplace nodes on the task scheduler - compression is not parallelized
 };
 
 interface IKeyBuilder : public IInterface
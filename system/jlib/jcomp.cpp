@@ -42,6 +42,7 @@
 #include "jdebug.hpp"
 #include "jcomp.ipp"
 #include "jhash.hpp"
+#include "jmd5.hpp"
 
 #define CC_EXTRA_OPTIONS        ""
 #ifdef GENERATE_LISTING
@@ -237,6 +238,13 @@ public:
     Semaphore          &finishedCompiling;
     StringBuffer       &batchOutText;
     bool                describeOnly;
+    //Only set if the compiled object may be shared via the object cache
+    StringBuffer        preprocessCmdline;
+    StringBuffer        preprocessedCompileCmdline;
+    StringBuffer        preprocessedName;
+    StringBuffer        objectName;
+    StringBuffer        optionsHash;
+    StringAttr          cacheDir;
 };
 
 //===========================================================================
@@ -370,6 +378,33 @@ CppCompiler::CppCompiler(const char * _coreName, const char * _sourceDir, const
     linkFailed = false;
 }
 
+void CppCompiler::setObjectCacheDir(const char * dir)
+{
+    if (targetCompiler == Vs6CppCompiler)
+        return;
+    objectCacheDir.set(dir);
+    if (!isEmptyString(dir))
+        recursiveCreateDirectory(dir);
+}
+
+void CppCompiler::getCompilerIdentity(StringBuffer & out)
+{
+    //The name, size and timestamp of the compiler are used so that an upgraded compiler does not reuse stale objects
+    StringBuffer name, expanded;
+    name.append(CC_NAME_CPP[targetCompiler]);
+    expandRootDirectory(expanded, name);
+    dequote(expanded);
+    out.append(expanded);
+
+    Owned<IFile> compilerFile = createIFile(expanded);
+    CDateTime modified;
+    if (compilerFile->getTime(nullptr, &modified, nullptr))
+    {
+        StringBuffer timeText;
+        out.append('@').append(modified.getString(timeText)).append(':').append(compilerFile->size());
+    }
+}
+
 void CppCompiler::addCompileOption(const char * option)
 {
     compilerOptions.append(' ').append(option);
@@ -515,6 +550,7 @@ bool CppCompiler::compile()
     Semaphore finishedCompiling;
     int numSubmitted = 0;
     numFailed.store(0);
+    numCached.store(0);
 
     if (reportOnly())
         batchOutText.append("#compile").newline();
@@ -546,6 +582,9 @@ bool CppCompiler::compile()
             finishedCompiling.wait();
     }
 
+    if (numCached && verbose)
+        DBGLOG("%u of %u objects reused from object cache %s", numCached.load(), numSubmitted, objectCacheDir.str());
+
     if (numFailed > 0)
         ret = false;
     else if (!onlyCompile && !precompileHeader)
@@ -619,15 +658,18 @@ bool CppCompiler::compileFile(IThreadPool * pool, const char * filename, const c
     }
     cmdline.append(filename);
     cmdline.append("\" ");
-    expandCompileOptions(cmdline, isC);
+
+    StringBuffer options;
+    expandCompileOptions(options, isC);
 
     if (useDebugLibrary)
-        cmdline.append(" ").append(LIBFLAG_DEBUG[targetCompiler]);
+        options.append(" ").append(LIBFLAG_DEBUG[targetCompiler]);
     else
-        cmdline.append(" ").append(LIBFLAG_RELEASE[targetCompiler]);
+        options.append(" ").append(LIBFLAG_RELEASE[targetCompiler]);
+
+    _addInclude(options, stdIncludes);
+    cmdline.append(options);
 
-    _addInclude(cmdline, stdIncludes);
-    
     if (targetCompiler == Vs6CppCompiler)
     {
         if (targetDir.get())
@@ -659,6 +701,43 @@ bool CppCompiler::compileFile(IThreadPool * pool, const char * filename, const c
     if (verbose)
         DBGLOG("%s", expanded.str());
     parm.setown(new CCompilerThreadParam(expanded, finishedCompiling, logFile, batchOutText, reportOnly()));
+
+    //The object cache is keyed on the preprocessed source (ignoring line markers, so the name of the generated file
+    //does not matter) combined with the compiler and every option that can affect the generated object.  If the
+    //object is not in the cache the preprocessed source is compiled, rather than preprocessing the source again.
+    if (!objectCacheDir.isEmpty() && !precompileHeader && !reportOnly())
+    {
+        getObjectName(parm->objectName, filename);
+        parm->preprocessedName.append(parm->objectName).append(isC ? ".i" : ".ii");
+
+        StringBuffer preprocess;
+        preprocess.append(isC ? CC_NAME_C[targetCompiler] : CC_NAME_CPP[targetCompiler]);
+        preprocess.append(" \"");
+        if (sourceDir.length())
+        {
+            preprocess.append(sourceDir);
+            addPathSepChar(preprocess);
+        }
+        preprocess.append(filename).append("\" ").append(options);
+        preprocess.append(" -E -o \"").append(parm->preprocessedName).append("\"");
+        if (flags)
+            preprocess.append(" ").append(flags);
+        expandRootDirectory(parm->preprocessCmdline, preprocess);
+
+        StringBuffer compilePreprocessed;
+        compilePreprocessed.append(isC ? CC_NAME_C[targetCompiler] : CC_NAME_CPP[targetCompiler]);
+        compilePreprocessed.append(" \"").append(parm->preprocessedName).append("\" ").append(options);
+        compilePreprocessed.append(" -o \"").append(parm->objectName).append("\"");
+        if (flags)
+            compilePreprocessed.append(" ").append(flags);
+        expandRootDirectory(parm->preprocessedCompileCmdline, compilePreprocessed);
+
+        StringBuffer identity;
+        getCompilerIdentity(identity);
+        identity.append(isC ? " c:" : " c++:").append(options).append(' ').append(flags);
+        md5_string2(identity, parm->optionsHash);
+        parm->cacheDir.set(objectCacheDir);
+    }
     pool->start(parm.get());
 
     return true;
@@ -1016,6 +1095,100 @@ public:
     }
     virtual void init(void *_params) override    { params.set((CCompilerThreadParam *)_params); }
 
+    bool runCommand(const char * cmdline, const char * logfile, DWORD & runcode)
+    {
+        bool success = invoke_program(cmdline, runcode, false, logfile, &handle, true, okToAbort);
+        if (success)
+            wait_program(handle, runcode, true);
+        handle = 0;
+        return success;
+    }
+
+    //Line markers contain the name of the generated file, so they are not included in the hash.  They are kept in
+    //the preprocessed file so that errors and debug information still refer to the original source.  Blank lines,
+    //which the preprocessor uses in place of short runs of comments or directives, are also ignored.
+    static void getPreprocessedHash(const char * filename, StringBuffer & out)
+    {
+        StringBuffer text;
+        text.loadFile(filename);
+
+        md5_state_t state;
+        md5_init(&state);
+        const char * cur = text.str();
+        const char * end = cur + text.length();
+        while (cur < end)
+        {
+            const char * eol = (const char *)memchr(cur, '\n', end - cur);
+            const char * next = eol ? eol + 1 : end;
+            bool isBlank = (cur[0] == '\n');
+            bool isLineMarker = (cur[0] == '#') && (cur + 2 < next) && (cur[1] == ' ') && isdigit((unsigned char)cur[2]);
+            if (!isBlank && !isLineMarker)
+                md5_append(&state, (const md5_byte_t *)cur, (int)(next - cur));
+            cur = next;
+        }
+
+        md5_byte_t digest[16];
+        md5_finish(&state, digest);
+        for (unsigned i = 0; i < sizeof(digest); i++)
+            out.appendf("%02x", digest[i]);
+    }
+
+    bool getCachedObjectName(StringBuffer & cacheName)
+    {
+        DWORD runcode = 0;
+        StringBuffer logfile(params->preprocessedName);
+        logfile.append(".log");
+        bool ok = runCommand(params->preprocessCmdline, logfile, runcode) && (runcode == 0) && !aborted;
+        removeFileTraceIfFail(logfile);
+        if (ok)
+        {
+            StringBuffer sourceHash;
+            getPreprocessedHash(params->preprocessedName, sourceHash);
+            cacheName.append(params->cacheDir);
+            addPathSepChar(cacheName).append(sourceHash).append('_').append(params->optionsHash).append(".o");
+        }
+        return ok;
+    }
+
+    bool restoreCachedObject(const char * cacheName)
+    {
+        Owned<IFile> cached = createIFile(cacheName);
+        if (!cached->exists())
+            return false;
+        try
+        {
+            Owned<IFile> target = createIFile(params->objectName);
+            cached->copyTo(target, DEFAULT_COPY_BLKSIZE, nullptr, true);
+            //Update the modified time so the cache directory can be pruned on a least recently used basis
+            CDateTime now;
+            now.setNow();
+            cached->setTime(nullptr, &now, nullptr);
+            return true;
+        }
+        catch (IException * e)
+        {
+            EXCLOG(e, "CCompilerWorker: failed to restore cached object");
+            e->Release();
+            return false;
+        }
+    }
+
+    void addCachedObject(const char * cacheName)
+    {
+        try
+        {
+            //Copied via a temporary file so that other compilers sharing the cache never see a partial object
+            Owned<IFile> source = createIFile(params->objectName);
+            Owned<IFile> cached = createIFile(cacheName);
+            source->copyTo(cached, DEFAULT_COPY_BLKSIZE, nullptr, true);
+        }
+        catch (IException * e)
+        {
+            EXCLOG(e, "CCompilerWorker: failed to add object to cache");
+            e->Release();
+        }
+    }
+
     virtual void threadmain() override
     {
         DWORD runcode = 0;
@@ -1032,9 +1205,22 @@ public:
             }
             else
             {
-                success = invoke_program(params->cmdline, runcode, false, params->logfile, &handle, true, okToAbort);
-                if (success)
-                    wait_program(handle, runcode, true);
+                StringBuffer cacheName;
+                if (params->preprocessCmdline.length() && getCachedObjectName(cacheName) && restoreCachedObject(cacheName))
+                {
+                    compiler->numCached++;
+                    success = true;
+                }
+                else
+                {
+                    //Avoid preprocessing the source a second time if the preprocessed source is available
+                    const char * cmdline = cacheName.length() ? params->preprocessedCompileCmdline.str() : params->cmdline.str();
+                    success = runCommand(cmdline, params->logfile, runcode);
+                    if (success && (runcode == 0) && !aborted && cacheName.length())
+                        addCachedObject(cacheName);
+                }
+                if (params->preprocessedName.length())
+                    removeFileTraceIfFail(params->preprocessedName);
             }
         }
         catch(IException* e)
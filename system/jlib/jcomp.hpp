@@ -70,6 +70,8 @@ public:
     virtual void setSaveTemps(bool _save) = 0;
     virtual void setPrecompileHeader(bool _pch) = 0;
     virtual void setAbortChecker(IAbortRequestCallback * abortChecker) = 0;
+    virtual void setObjectCacheDir(const char * dir) = 0;   // shared directory of compiled objects, keyed by preprocessed source and options
+    virtual unsigned queryNumCachedObjects() const = 0;     // number of objects reused from the object cache by the last compile()
     virtual void removeTemporary(const char *fname) = 0;
     virtual void removeTempDir(const char *fname) = 0;
     virtual bool reportOnly() const = 0;
@@ -51,6 +51,8 @@ public:
     virtual void setSaveTemps(bool _save) { saveTemps = _save; }
     virtual void setPrecompileHeader(bool _pch);
     virtual void setAbortChecker(IAbortRequestCallback * _abortChecker) {abortChecker = _abortChecker;}
+    virtual void setObjectCacheDir(const char * dir);
+    virtual unsigned queryNumCachedObjects() const { return numCached.load(); }
     virtual bool fireException(IException *e);
     virtual void removeTempDir(const char *fname);
     virtual void removeTemporary(const char *fname);
@@ -65,9 +67,11 @@ protected:
     bool compileFile(IThreadPool * pool, const char * filename, const char *flags, Semaphore & finishedCompiling);
     bool doLink();
     void writeLogFile(const char* filepath, StringBuffer& log) ;
+    void getCompilerIdentity(StringBuffer & out);
 
 public:
     std::atomic_uint numFailed;
+    std::atomic_uint numCached{0};
 
 protected:
     StringBuffer    compilerOptions;
@@ -84,6 +88,7 @@ protected:
     StringArray     linkerRPaths;
     StringAttr      ccLogPath;
     StringAttr      coreName;
+    StringAttr      objectCacheDir;
     unsigned        targetCompiler;
     unsigned        maxCompileThreads;
     bool            onlyCompile;
@@ -160,6 +160,8 @@
 #define JLIBERR_CompressStreamCompressorsDoesNotSupportMemorybufferOutput 6159
 #define JLIBERR_CompressTotalSizeTooLargeUncompressedUU    6160
 #define JLIBERR_CompressLz4compressorFlushcommittedInputSizeUExceedsMaximum 6161
+#define JLIBERR_CompressFailedToCreateZstdDictionary      6162
+#define JLIBERR_CompressFailedToLoadZstdDictionaryS        6163
 #define JLIBERR_ParseCouldNotLocateFilenameS               6170
 #define JLIBERR_ParseSavexmlCouldNotFindSToOpen            6171
 #define JLIBERR_ParseInvalidExtractXmlTextUsageXpath       6172
@@ -30,6 +30,7 @@
 #include "jerror.hpp"
 #include "jlzw.hpp"
 #include "jregexp.hpp"
+#include "jset.hpp"
 #include "jstring.hpp"
 #include "jutil.hpp"
 #include "jmisc.hpp"
@@ -66,6 +67,34 @@ static const CCharacterSet validTagCharacters([](unsigned char c) { return (!iss
 static const CCharacterSet validAttrCharacters([](unsigned char c) { return (c && !isspace(c) && c != '=' && c != '>' && c != '/'); });
 static const CCharacterSet notSpaceNorGreater([](unsigned char c) { return (!isspace(c) && c != '>'); });
 static const CCharacterSet wsCharSet([](unsigned char c) { return isspace(c); });
+// characters that can be copied verbatim from a JSON string (no escapes, control characters or multi-byte utf8 sequences)
+static const CCharacterSet jsonPlainStringCharSet([](unsigned char c) { return (c >= 0x20) && (c < 0x80) && (c != '"') && (c != '\\'); });
+
+// Returns the number of leading characters in [start, end) that are in jsonPlainStringCharSet, testing 8 at a time
+static size32_t scanJsonPlainRun(const byte *start, const byte *end)
+{
+    const byte *p = start;
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+    constexpr unsigned __int64 ones = 0x0101010101010101ULL;
+    constexpr unsigned __int64 highBits = 0x8080808080808080ULL;
+    while (end - p >= (ptrdiff_t)sizeof(unsigned __int64))
+    {
+        unsigned __int64 v;
+        memcpy(&v, p, sizeof(v));
+        unsigned __int64 quotes = v ^ (ones * '"');
+        unsigned __int64 escapes = v ^ (ones * '\\');
+        // The top bit of a byte is set if it is a control character, a quote, a backslash or not ascii.  A borrow can
+        // only flag bytes above one that really matched, so the lowest flagged byte is always the first to stop on.
+        unsigned __int64 stops = (((v - ones * 0x20) & ~v) | ((quotes - ones) & ~quotes) | ((escapes - ones) & ~escapes) | v) & highBits;
+        if (stops)
+            return (size32_t)(p - start) + countTrailingUnsetBits(stops) / 8;
+        p += sizeof(v);
+    }
+#endif
+    while ((p < end) && jsonPlainStringCharSet.includes(*p))
+        p++;
+    return (size32_t)(p - start);
+}
 
 class NullPTreeIterator final : implements IPropertyTreeIterator
 {
@@ -4860,6 +4889,7 @@ class CommonReaderBase : public CInterface
     byte *buf;
     size32_t bufSize, bufRemaining;
     size32_t bufOffset = 0;
+    const byte *nullTermEnd = nullptr; // only calculated if a bulk scan needs it
 protected:
     PTreeReaderOptions readerOptions;
     bool ignoreWhiteSpace, noRoot;
@@ -4874,6 +4904,12 @@ private:
         ignoreWhiteSpace = 0 != ((unsigned)readerOptions & (unsigned)ptr_ignoreWhiteSpace);
         noRoot = 0 != ((unsigned)readerOptions & (unsigned)ptr_noRoot);
     }
+    const byte *queryNullTermEnd()
+    {
+        if (!nullTermEnd)
+            nullTermEnd = buf + strlen((const char *)buf);
+        return nullTermEnd;
+    }
     void resetState()
     {
         bufOffset = 0;
@@ -5202,6 +5238,29 @@ protected:
         }
         return true;
     }
+    // Append the run of plain JSON string characters starting at nextChar, copying each buffered block in one go
+    void readJsonPlainRun(StringBuffer &out)
+    {
+        for (;;)
+        {
+            out.append(nextChar);
+
+            const byte *start = buf + bufOffset;
+            // the null terminator is not a plain character, so it ends the run just as the end of the buffer does
+            const byte *end = nullTerm ? queryNullTermEnd() : buf + bufRemaining;
+            size32_t numMatched = scanJsonPlainRun(start, end);
+            if (likely(numMatched > 0))
+            {
+                out.append(numMatched, (const char *)start);
+                bufOffset += numMatched;
+                curOffset += numMatched; // plain characters never include a newline
+            }
+
+            readNext();
+            if (!jsonPlainStringCharSet.includes(nextChar))
+                break;
+        }
+    }
     void readUntil(StringBuffer *out, char targetChar)
     {
         if (nextChar == targetChar)
@@ -5216,39 +5275,19 @@ protected:
                 out->append(nextChar);
 
             const byte *start = buf + bufOffset;
-            unsigned newlines = 0;
-
-            const byte *p = start;
+            const byte *p;
+            // use the (vectorized) library scans to find the end of the run, rather than testing each character in turn
             if (nullTerm)
             {
-                for (;;)
-                {
-                    char c = (char)*p;
-                    if (c == targetChar)
-                        break;
-                    if (unlikely(0 == c))
-                        break;
-
-                    if (unlikely(10 == c))
-                        newlines++;
-
-                    p++;
-                }
+                const char target[2] = { targetChar, '\0' };
+                p = start + strcspn((const char *)start, target);
             }
             else
             {
                 const byte *end = buf + bufRemaining;
-                while (p < end)
-                {
-                    char c = (char)*p;
-                    if (c == targetChar)
-                        break;
-
-                    if (unlikely(10 == c))
-                        newlines++;
-
-                    p++;
-                }
+                p = (const byte *)memchr(start, targetChar, end - start);
+                if (!p)
+                    p = end;
             }
 
             size32_t numMatched = p - start;
@@ -5257,7 +5296,7 @@ protected:
                 if (out)
                     out->append(numMatched, (const char *)start);
                 bufOffset += numMatched;
-                line += newlines;
+                line += (unsigned)std::count(start, p, (byte)10);
                 curOffset += numMatched;
             }
             if (!checkReadNext())
@@ -7590,6 +7629,11 @@ protected:
         bool decode=false;
         while ('\"'!=nextChar)
         {
+            if (jsonPlainStringCharSet.includes(nextChar))
+            {
+                readJsonPlainRun(s);
+                continue;
+            }
             if (nextChar=='\\')
                 decode=true;
             appendChar(s, nextChar);
@@ -3717,6 +3717,24 @@ bool ScopeFilter::canAlwaysPreFilter() const
     return (!ids && !scopeTypes && !scopes && maxDepth == UINT_MAX);
 }
 
+bool ScopeFilter::mayMatchActivityRange(unsigned minActivity, unsigned maxActivity) const
+{
+    //Only lists of ids can be checked cheaply - a scope or scope type filter may match anything
+    if (!ids)
+        return true;
+
+    ForEachItemIn(i, ids)
+    {
+        StatsScopeId id(ids.item(i));
+        if (id.queryScopeType() != SSTactivity)
+            return true;
+        unsigned activityId = id.queryActivity();
+        if ((activityId >= minActivity) && (activityId <= maxActivity))
+            return true;
+    }
+    return false;
+}
+
 int ScopeFilter::compareDepth(unsigned depth) const
 {
     if (depth < minDepth)
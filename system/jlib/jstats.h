@@ -375,6 +375,11 @@ public:
     int compareDepth(unsigned depth) const; // -1 too shallow, 0 a match, +1 too deep
     bool hasSingleMatch() const;
     bool canAlwaysPreFilter() const;
+    /*
+     * Return false if the filter can only match activities, and none of them have an id in the range minActivity..maxActivity
+     * Used to avoid expanding collections of statistics that cannot contain any matches.
+     */
+    bool mayMatchActivityRange(unsigned minActivity, unsigned maxActivity) const;
     void finishedFilter();
 
     const StringArray & queryScopes() const { return scopes; }
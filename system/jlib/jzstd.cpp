@@ -27,6 +27,7 @@
 #include "jerror.hpp"
 
 #include <zstd.h>
+#include <zdict.h>
 
 class CZStdCompressor final : public CBlockCompressor
 {
@@ -137,6 +138,50 @@ IExpander *createZStdExpander()
 
 //---------------------------------------------------------------------------------------------------------------------
 
+class CZStdDictionary final : public CInterfaceOf<IZStdDictionary>
+{
+public:
+    CZStdDictionary(size32_t len, const void * _data) : data(len, _data)
+    {
+        ddict = ZSTD_createDDict(data.get(), len);
+        if (!ddict)
+            throw makeStringException(JLIBERR_CompressFailedToCreateZstdDictionary, "Failed to create ZStd dictionary");
+    }
+
+    ~CZStdDictionary()
+    {
+        ZSTD_freeDDict(ddict);
+    }
+
+    virtual size32_t querySize() const override { return (size32_t)data.length(); }
+    virtual const void * queryData() const override { return data.get(); }
+
+    const ZSTD_DDict * queryDDict() const { return ddict; }
+
+protected:
+    MemoryAttr data;
+    ZSTD_DDict * ddict = nullptr;    // Digested once, and then shared by all the expanders that use the dictionary
+};
+
+IZStdDictionary *createZStdDictionary(size32_t len, const void * data)
+{
+    return new CZStdDictionary(len, data);
+}
+
+IZStdDictionary *trainZStdDictionary(size32_t maxSize, unsigned numSamples, const size_t * sampleSizes, const void * samples)
+{
+    MemoryAttr buffer(maxSize);
+    size_t dictSize = ZDICT_trainFromBuffer(buffer.mem(), maxSize, samples, sampleSizes, numSamples);
+    if (ZDICT_isError(dictSize))
+    {
+        DBGLOG("Unable to train ZStd dictionary from %u samples: %s", numSamples, ZDICT_getErrorName(dictSize));
+        return nullptr;
+    }
+    return new CZStdDictionary((size32_t)dictSize, buffer.get());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
 // See notes on CStreamCompressor for the serialized stream format
 
 // The ZStd streaming functions compress data in blocks. We are using ZSTD_e_flush.
@@ -147,7 +192,7 @@ IExpander *createZStdExpander()
 class CZStdStreamCompressor final : public CStreamCompressor
 {
 public:
-    CZStdStreamCompressor(const char * options)
+    CZStdStreamCompressor(const char * options, const IZStdDictionary * _dictionary) : dictionary(_dictionary)
     {
         auto processOption = [this](const char * option, const char * textValue)
         {
@@ -157,6 +202,15 @@ public:
         zstdStream = ZSTD_createCStream();
         if (!zstdStream)
             throw makeStringException(JLIBERR_CompressFailedToCreateZstdCompressionStream, "Failed to create ZStd compression stream");
+        if (dictionary)
+        {
+            //The level and dictionary are sticky, so the dictionary is only digested once rather than for every block
+            size_t result = ZSTD_CCtx_setParameter(zstdStream, ZSTD_c_compressionLevel, compressionLevel);
+            if (!ZSTD_isError(result))
+                result = ZSTD_CCtx_loadDictionary(zstdStream, dictionary->queryData(), dictionary->querySize());
+            if (ZSTD_isError(result))
+                throw makeStringExceptionV(JLIBERR_CompressFailedToLoadZstdDictionaryS, "Failed to load ZStd dictionary: %s", ZSTD_getErrorName(result));
+        }
     }
 
     virtual ~CZStdStreamCompressor()
@@ -168,7 +222,7 @@ public:
     virtual void open(void *buf, size32_t max, size32_t fixedRowSize, bool _allowPartialWrites) override
     {
         CStreamCompressor::open(buf, max, fixedRowSize, _allowPartialWrites);
-        size_t result = ZSTD_initCStream(zstdStream, compressionLevel);
+        size_t result = initStream();
         if (ZSTD_isError(result))
             throw makeStringExceptionV(JLIBERR_CompressFailedToInitializeZstdCompressionStreamS, "Failed to initialize ZStd compression stream: %s", ZSTD_getErrorName(result));
     }
@@ -191,9 +245,17 @@ protected:
         return true;
     };
 
+    size_t initStream()
+    {
+        //ZSTD_initCStream() would discard the dictionary, so only reset the session when one is in use
+        if (dictionary)
+            return ZSTD_CCtx_reset(zstdStream, ZSTD_reset_session_only);
+        return ZSTD_initCStream(zstdStream, compressionLevel);
+    }
+
     virtual void resetStreamContext() override
     {
-        size_t result = ZSTD_initCStream(zstdStream, compressionLevel);
+        size_t result = initStream();
         if (ZSTD_isError(result))
             throw makeStringExceptionV(JLIBERR_CompressFailedToInitializeZstdCompressionStreamS_1, "Failed to initialize ZStd compression stream: %s", ZSTD_getErrorName(result));
     }
@@ -250,6 +312,7 @@ protected:
 
 protected:
     ZSTD_CStream * zstdStream = nullptr;
+    Linked<const IZStdDictionary> dictionary;
 
     //Options for configuring the compressor:
     int compressionLevel = ZSTD_CLEVEL_DEFAULT;
@@ -259,11 +322,17 @@ protected:
 class CZStdStreamExpander final : public CStreamExpander
 {
 public:
-    CZStdStreamExpander()
+    CZStdStreamExpander(const IZStdDictionary * _dictionary) : dictionary(_dictionary)
     {
         zstdDStream = ZSTD_createDStream();
         if (!zstdDStream)
             throw makeStringException(JLIBERR_CompressFailedToCreateZstdDecompressionStream, "Failed to create ZStd decompression stream");
+        if (dictionary)
+        {
+            size_t result = ZSTD_DCtx_refDDict(zstdDStream, static_cast<const CZStdDictionary *>(dictionary.get())->queryDDict());
+            if (ZSTD_isError(result))
+                throw makeStringExceptionV(JLIBERR_CompressFailedToLoadZstdDictionaryS, "Failed to load ZStd dictionary: %s", ZSTD_getErrorName(result));
+        }
     }
 
     ~CZStdStreamExpander()
@@ -275,7 +344,7 @@ public:
     virtual size32_t expandDirect(size32_t destSize, void * dest, size32_t srcSize, const void * src) override
     {
         assertex(destSize != 0);
-        size_t result = ZSTD_decompress(dest, destSize, src, srcSize);
+        size_t result = dictionary ? ZSTD_decompressDCtx(zstdDStream, dest, destSize, src, srcSize) : ZSTD_decompress(dest, destSize, src, srcSize);
         if (ZSTD_isError(result))
             throw makeStringExceptionV(JLIBERR_CompressZstdDecompressionErrorS_1, "ZStd decompression error: %s", ZSTD_getErrorName(result));
 
@@ -285,7 +354,8 @@ public:
 protected:
     virtual void resetStreamContext() override
     {
-        size_t result = ZSTD_initDStream(zstdDStream);
+        //ZSTD_initDStream() would discard the dictionary, so only reset the session when one is in use
+        size_t result = dictionary ? ZSTD_DCtx_reset(zstdDStream, ZSTD_reset_session_only) : ZSTD_initDStream(zstdDStream);
         if (ZSTD_isError(result))
             throw makeStringExceptionV(JLIBERR_CompressFailedToResetZstdDecompressionStreamS, "Failed to reset ZStd decompression stream: %s", ZSTD_getErrorName(result));
     }
@@ -309,16 +379,27 @@ protected:
 
 protected:
     ZSTD_DStream * zstdDStream = nullptr;
+    Linked<const IZStdDictionary> dictionary;
 };
 
 //---------------------------------------------------------------------------------------------------------------------
 
 ICompressor *createZStdStreamCompressor(const char * options)
 {
-    return new CZStdStreamCompressor(options);
+    return new CZStdStreamCompressor(options, nullptr);
 }
 
 IExpander *createZStdStreamExpander()
 {
-    return new CZStdStreamExpander();
+    return new CZStdStreamExpander(nullptr);
+}
+
+ICompressor *createZStdStreamCompressor(const char * options, const IZStdDictionary * dictionary)
+{
+    return new CZStdStreamCompressor(options, dictionary);
+}
+
+IExpander *createZStdStreamExpander(const IZStdDictionary * dictionary)
+{
+    return new CZStdStreamExpander(dictionary);
 }
@@ -26,4 +26,20 @@ extern jlib_decl IExpander   *createZStdExpander();
 extern jlib_decl ICompressor *createZStdStreamCompressor(const char * options);
 extern jlib_decl IExpander   *createZStdStreamExpander();
 
+// A dictionary trained from samples of the data being compressed.  It allows lots of small blocks that share common
+// content (e.g. the leaf nodes of an index) to be compressed much better than when each block is compressed on its own.
+// The same dictionary must be supplied to expand the data.  A dictionary can safely be shared between threads.
+interface IZStdDictionary : extends IInterface
+{
+    virtual size32_t querySize() const = 0;
+    virtual const void * queryData() const = 0;
+};
+
+extern jlib_decl IZStdDictionary *createZStdDictionary(size32_t len, const void * data);
+// Returns nullptr if a dictionary could not be trained from the samples - e.g. if there were too few of them
+extern jlib_decl IZStdDictionary *trainZStdDictionary(size32_t maxSize, unsigned numSamples, const size_t * sampleSizes, const void * samples);
+
+extern jlib_decl ICompressor *createZStdStreamCompressor(const char * options, const IZStdDictionary * dictionary);
+extern jlib_decl IExpander   *createZStdStreamExpander(const IZStdDictionary * dictionary);
+
 #endif
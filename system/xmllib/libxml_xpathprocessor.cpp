@@ -1665,6 +1665,10 @@ private:
     xmlDocPtr doc = nullptr;
     xmlNodePtr root = nullptr;
     xmlXPathContextPtr xpathCtx = nullptr;
+    // Section content set as text is only parsed into the document when the section (or the document as a whole) is
+    // first accessed, so large sections that no script looks at (e.g. a backend response) are never parsed at all.
+    // Malformed content is reported by that first access, and by every later one.
+    std::map<std::string, std::string> unparsedContent;
 
 public:
     CSectionalXmlDocModel(void *_userData) : userData(_userData)
@@ -1690,22 +1694,65 @@ private:
         if (isEmptyString(name) || strpbrk(name, "/[]()*?"))
             throw MakeStringException(-1, "CSectionalXmlDocModel:removeSection invalid section name %s", name);
     }
+    xmlNodePtr evalFirstNode(const char *xpath)
+    {
+        xmlNodePtr node = nullptr;
+        xmlXPathObjectPtr eval = xmlXPathEval((const xmlChar *) xpath, xpathCtx);
+        if (eval && XPATH_NODESET == eval->type && eval->nodesetval && eval->nodesetval->nodeNr && eval->nodesetval->nodeTab!=nullptr)
+            node = eval->nodesetval->nodeTab[0];
+        xmlXPathFreeObject(eval);
+        return node;
+    }
+    void parseContent(xmlNodePtr sect, const char *section, const char *xml, size_t len)
+    {
+        xmlDocPtr contentDoc = xmlReadMemory(xml, len, section, nullptr, 0);
+        if (!contentDoc)
+            throw MakeStringException(-1, "CSectionalXmlDocModel:setContent xml string: Unable to parse %s XML content", section);
+
+        xmlNodePtr contentRoot = xmlDocGetRootElement(contentDoc);
+        if (!contentRoot)
+        {
+            xmlFreeDoc(contentDoc);
+            throw MakeStringException(-1, "CSectionalXmlDocModel:setContent xml string: Missing root node for %s XML content", section);
+        }
+
+        xmlNodePtr contentCopy = xmlDocCopyNode(contentRoot, doc, 1);
+        xmlFreeDoc(contentDoc);
+        if (!contentCopy)
+            throw MakeStringException(-1, "CSectionalXmlDocModel:setContent xml string: Unable to copy %s XML content", section);
+
+        xmlAddChild(sect, contentCopy);
+    }
+    void ensureParsed(const char *name)
+    {
+        auto it = unparsedContent.find(name);
+        if (it == unparsedContent.end())
+            return;
+        // Only discard the text once it has been added to the document, so a failure is reported on every access
+        // rather than leaving the section silently empty
+        xmlNodePtr sect = evalFirstNode(name);
+        if (sect)
+            parseContent(sect, name, it->second.c_str(), it->second.length());
+        unparsedContent.erase(it);
+    }
+    void ensureAllParsed()
+    {
+        while (!unparsedContent.empty())
+            ensureParsed(unparsedContent.begin()->first.c_str());
+    }
     xmlNodePtr getSectionNode(const char *name, const char *xpath="*[1]")
     {
         sanityCheckSectionName(name);
+        ensureParsed(name);
         StringBuffer fullXpath(name);
         if (!isEmptyString(xpath))
             fullXpath.append('/').append(xpath);
-        xmlNodePtr sect = nullptr;
-        xmlXPathObjectPtr eval = xmlXPathEval((const xmlChar *) fullXpath.str(), xpathCtx);
-        if (eval && XPATH_NODESET == eval->type && eval->nodesetval && eval->nodesetval->nodeNr && eval->nodesetval->nodeTab!=nullptr)
-            sect = eval->nodesetval->nodeTab[0];
-        xmlXPathFreeObject(eval);
-        return sect;
+        return evalFirstNode(fullXpath);
     }
 
     void addXpathCtxConfigInputs(IXpathContext *tgtXpathCtx)
     {
+        ensureParsed("config");
         xmlXPathObjectPtr eval = xmlXPathEval((const xmlChar *) "config/*/Transform/Param", xpathCtx);
         if (!eval)
             return;
@@ -1727,6 +1774,7 @@ private:
     }
     const char *getXPathString(const char *xpath, StringBuffer &s) const override
     {
+        const_cast<CSectionalXmlDocModel *>(this)->ensureAllParsed();
         xmlXPathObjectPtr eval = xmlXPathEval((const xmlChar *) xpath, xpathCtx);
         if (eval)
         {
@@ -1744,6 +1792,7 @@ private:
     }
     __int64 getXPathInt64(const char *xpath, __int64 dft=0) const override
     {
+        const_cast<CSectionalXmlDocModel *>(this)->ensureAllParsed();
         __int64 ret = dft;
         xmlXPathObjectPtr eval = xmlXPathEval((const xmlChar *) xpath, xpathCtx);
         if (eval)
@@ -1761,6 +1810,7 @@ private:
     }
     bool getXPathBool(const char *xpath, bool dft=false) const override
     {
+        const_cast<CSectionalXmlDocModel *>(this)->ensureAllParsed();
         bool ret = dft;
         xmlXPathObjectPtr eval = xmlXPathEval((const xmlChar *) xpath, xpathCtx);
         if (eval)
@@ -1821,6 +1871,7 @@ private:
     void removeSection(const char *name)
     {
         sanityCheckSectionName(name);
+        unparsedContent.erase(name);
         xmlXPathObjectPtr eval = xmlXPathEval((const xmlChar *) name, xpathCtx);
         if (!eval)
             return;
@@ -1848,27 +1899,10 @@ private:
     }
     virtual void setContent(const char *section, const char *xml) override
     {
-        xmlNodePtr sect = replaceSection(section);
+        replaceSection(section); // NB: the (empty) section node is added now to preserve the section order
         if (xml==nullptr) //means delete content
             return;
-
-        xmlDocPtr contentDoc = xmlReadMemory(xml, strlen(xml), section, nullptr, 0);
-        if (!contentDoc)
-            throw MakeStringException(-1, "CSectionalXmlDocModel:setContent xml string: Unable to parse %s XML content", section);
-
-        xmlNodePtr contentRoot = xmlDocGetRootElement(contentDoc);
-        if (!contentRoot)
-        {
-            xmlFreeDoc(contentDoc);
-            throw MakeStringException(-1, "CSectionalXmlDocModel:setContent xml string: Missing root node for %s XML content", section);
-        }
-
-        xmlNodePtr contentCopy = xmlDocCopyNode(contentRoot, doc, 1);
-        xmlFreeDoc(contentDoc);
-        if (!contentCopy)
-            throw MakeStringException(-1, "CSectionalXmlDocModel:setContent xml string: Unable to copy %s XML content", section);
-
-        xmlAddChild(sect, contentCopy);
+        unparsedContent[section] = xml;
     }
     virtual void appendContent(const char *section, const char *name, const char *xml) override
     {
@@ -1974,7 +2008,9 @@ private:
     virtual void toXML(StringBuffer &xml, const char *section, bool includeParentNode=false) override
     {
         xmlNodePtr sect = root;
-        if (!isEmptyString(section))
+        if (isEmptyString(section))
+            ensureAllParsed();
+        else
         {
             sect = getSectionNode(section, includeParentNode ? nullptr : "*[1]");
             if (!sect)
@@ -2007,6 +2043,8 @@ private:
     }
     IXpathContext* createXpathContext(IXpathContext *primaryContext, const char *section, bool strictParameterDeclaration) override
     {
+        // scripts may evaluate xpaths against any section
+        ensureAllParsed();
         xmlNodePtr sect = nullptr;
         if (!isEmptyString(section))
         {
@@ -2057,6 +2095,7 @@ class LibXml2XPathProcessorTests : public CppUnit::TestFixture
         CPPUNIT_TEST(testWriteUTF8);
         CPPUNIT_TEST(testAddXmlContentWellFormed);
         CPPUNIT_TEST(testAddXmlContentMalformed);
+        CPPUNIT_TEST(testDeferredSectionContent);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -2106,6 +2145,34 @@ public:
         CPPUNIT_ASSERT_THROWS_IEXCEPTION(xpathCtx->addXmlContent("<child>unclosed"), "addXmlContent: expected exception for malformed XML was not thrown");
     }
 
+    void testDeferredSectionContent()
+    {
+        // Section content is parsed into the document on first access. Verify that malformed content is reported by
+        // each access to it, that sections retain the order they were set in, and that replacing a section discards any
+        // content not yet parsed.
+        Owned<ISectionalXmlDocModel> docModel(createSectionalXmlDocModel(nullptr));
+        docModel->setContent("first", "<a>1</a>");
+        docModel->setContent("unused", "<c>3</c>");
+        docModel->setContent("second", "<b>2</b>");
+
+        docModel->setContent("malformed", "<malformed>");
+
+        StringBuffer result;
+        // Note: libxml2 reports an error for this test directly to stderr, but it is not a failure
+        CPPUNIT_ASSERT_THROWS_IEXCEPTION(docModel->toXML(result, "malformed"), "expected exception for malformed section XML was not thrown");
+        CPPUNIT_ASSERT_THROWS_IEXCEPTION(docModel->toXML(result, "malformed"), "malformed section XML not reported on a later access");
+        docModel->setContent("malformed", (const char *) nullptr);
+
+        docModel->toXML(result, "second");
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("deferred section content mismatch", std::string("<b>2</b>"), std::string(result.str()));
+
+        docModel->setContent("unused", (const char *) nullptr);
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("xpath over deferred sections failed", std::string("1"), std::string(docModel->getXPathString("first/a", result.clear())));
+        CPPUNIT_ASSERT_MESSAGE("replaced section content not discarded", !docModel->getXPathBool("unused/c"));
+        docModel->toXML(result.clear());
+        CPPUNIT_ASSERT_MESSAGE("section order not preserved", strstr(result, "<first>") < strstr(result, "<second>"));
+    }
+
 private:
     ISectionalXmlDocModel* createScriptContext(const char* section, const char* content)
     {
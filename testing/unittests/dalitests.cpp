@@ -816,6 +816,7 @@ class CDaliSDSStressTests : public CppUnit::TestFixture
         CPPUNIT_TEST(testSDSSubs2);
         CPPUNIT_TEST(testSDSNodeSubs);
         CPPUNIT_TEST(testEphemeralLocks);
+        CPPUNIT_TEST(testSnapshotConnect);
         CPPUNIT_TEST(testSiblingPerfLocal);
         CPPUNIT_TEST(testSiblingPerfDali);
         CPPUNIT_TEST(testSiblingPerfContention);
@@ -1471,6 +1472,39 @@ public:
         for (auto &f: results)
             f.get();
     }
+    void testSnapshotConnect()
+    {
+        const char *xpath = "/DAREGRESS/SnapshotTest";
+        Owned<IRemoteConnection> writeConn = querySDS().connect(xpath, myProcessSession(), RTM_LOCK_WRITE | RTM_CREATE, 2000);
+        writeConn->queryRoot()->setProp("@state", "committed");
+        writeConn->queryRoot()->setProp("child/@val", "1");
+        writeConn->commit();
+        writeConn->queryRoot()->setProp("@state", "pending");
+
+        // A snapshot must not wait for the write lock (a timeout of 0 would fail immediately if it did),
+        // and should only see the committed state
+        Owned<IRemoteConnection> snapshot = querySDS().connect(xpath, myProcessSession(), RTM_SNAPSHOT, 0);
+        CPPUNIT_ASSERT(snapshot);
+        CPPUNIT_ASSERT_EQUAL(std::string("committed"), std::string(snapshot->queryRoot()->queryProp("@state")));
+        CPPUNIT_ASSERT_EQUAL(1, snapshot->queryRoot()->getPropInt("child/@val"));
+
+        bool commitFailed = false;
+        try
+        {
+            snapshot->commit();
+        }
+        catch (IException *e)
+        {
+            commitFailed = true;
+            e->Release();
+        }
+        CPPUNIT_ASSERT(commitFailed);
+        snapshot.clear();
+
+        Owned<IRemoteConnection> missing = querySDS().connect("/DAREGRESS/SnapshotTestMissing", myProcessSession(), RTM_SNAPSHOT, 0);
+        CPPUNIT_ASSERT(!missing);
+        writeConn->close(true);
+    }
     void createLevel(IPropertyTree *parent, unsigned nodeSiblings, unsigned leafSiblings, unsigned attributes, unsigned depth, unsigned level)
     {
         StringBuffer aname;
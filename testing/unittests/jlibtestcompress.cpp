@@ -34,6 +34,7 @@
 #include "jset.hpp"
 #include "rmtfile.hpp"
 #include "jlzw.hpp"
+#include "jzstd.hpp"
 #include "jqueue.hpp"
 #include "jregexp.hpp"
 #include "jsecrets.hpp"
@@ -495,6 +496,7 @@ class JlibCompressionStandardTest : public JlibCompressionTestBase
         CPPUNIT_TEST(testStandardCompression);
         CPPUNIT_TEST(testOverflowBug);
         CPPUNIT_TEST(testIncompressible);
+        CPPUNIT_TEST(testZStdDictionary);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -673,6 +675,64 @@ public:
 
         END_TEST
     }
+
+    size32_t compressBlock(MemoryBuffer & out, ICompressor * compressor, size32_t len, const byte * data)
+    {
+        size32_t limit = len + 0x100;
+        compressor->open(out.clear().ensureCapacity(limit), limit, 0, false);
+        CPPUNIT_ASSERT_EQUAL(len, compressor->write(data, len));
+        compressor->close();
+        out.setLength(compressor->buflen());
+        return out.length();
+    }
+
+    void testZStdDictionary()
+    {
+        START_TEST
+
+        //Small blocks of rows that share common content, similar to the leaves of an index
+        constexpr unsigned numRows = 20000;
+        constexpr unsigned rowsPerBlock = 100;
+        MemoryBuffer rows;
+        std::vector<size_t> rowSizes;
+        StringBuffer row;
+        for (unsigned i = 0; i < numRows; i++)
+        {
+            row.clear().appendf("customer%08u|%s|%s|account%06u|", i, (i % 3) ? "ACTIVE" : "SUSPENDED", (i % 5) ? "UNITED KINGDOM" : "UNITED STATES", i % 997);
+            rows.append(row.length(), row.str());
+            rowSizes.push_back(row.length());
+        }
+
+        Owned<IZStdDictionary> dictionary = trainZStdDictionary(0x4000, numRows, rowSizes.data(), rows.bytes());
+        CPPUNIT_ASSERT(dictionary);
+        CPPUNIT_ASSERT(dictionary->querySize() != 0);
+
+        size32_t blockLen = 0;
+        for (unsigned i = 0; i < rowsPerBlock; i++)
+            blockLen += rowSizes[i];
+
+        MemoryBuffer plain, compressed;
+        Owned<ICompressor> plainCompressor = createZStdStreamCompressor("level=6");
+        Owned<ICompressor> dictionaryCompressor = createZStdStreamCompressor("level=6", dictionary);
+        size32_t plainSize = compressBlock(plain, plainCompressor, blockLen, rows.bytes());
+        size32_t dictionarySize = compressBlock(compressed, dictionaryCompressor, blockLen, rows.bytes());
+        DBGLOG("ZStd dictionary(%u): %u bytes compressed to %u without and %u with the dictionary", dictionary->querySize(), blockLen, plainSize, dictionarySize);
+        CPPUNIT_ASSERT(dictionarySize < plainSize);
+
+        //Expand with a copy of the dictionary, as an index would once it had been reloaded
+        Owned<IZStdDictionary> loaded = createZStdDictionary(dictionary->querySize(), dictionary->queryData());
+        Owned<IExpander> expander = createZStdStreamExpander(loaded);
+        size32_t expandedLen = expander->init(compressed.bytes());
+        CPPUNIT_ASSERT_EQUAL(blockLen, expandedLen);
+        MemoryBuffer expanded;
+        expander->expand(expanded.reserveTruncate(expandedLen));
+        CPPUNIT_ASSERT(memcmp(expanded.bytes(), rows.bytes(), blockLen) == 0);
+
+        //Each compressor session must start afresh, so a second block compresses to the same size
+        CPPUNIT_ASSERT_EQUAL(dictionarySize, compressBlock(compressed, dictionaryCompressor, blockLen, rows.bytes()));
+
+        END_TEST
+    }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION( JlibCompressionStandardTest );
@@ -2509,9 +2509,48 @@ class JlibIPTTest : public CppUnit::TestFixture
         CPPUNIT_TEST(testMergeConfig);
         CPPUNIT_TEST(testRemoveReuse);
         CPPUNIT_TEST(testSpecialTags);
+        CPPUNIT_TEST(testJsonStringRuns);
     CPPUNIT_TEST_SUITE_END();
 
 public:
+    void testJsonStringRuns()
+    {
+        // Runs of plain characters are scanned several bytes at a time, so check runs of every length up to and beyond
+        // the scan width, ended by each kind of character that stops a run, from both null terminated and sized input
+        static const char * const stoppers[][2] = { { "\\\"", "\"" }, { "\\\\", "\\" }, { "\\n", "\n" }, { "\\u0041", "A" }, { "出", "出" }, { "", "" } };
+        StringBuffer json("{\"v\": [");
+        std::vector<std::string> expected;
+        for (unsigned len = 0; len < 20; len++)
+        {
+            for (auto & stopper : stoppers)
+            {
+                StringBuffer plain;
+                for (unsigned i = 0; i < len; i++)
+                    plain.append((char)('a' + (len + i) % 26));
+                if (expected.size())
+                    json.append(',');
+                json.append('"').append(plain).append(stopper[0]).append("xyz\"");
+                expected.push_back(std::string(plain.str()) + stopper[1] + "xyz");
+            }
+        }
+        json.append("]}");
+
+        Owned<IPropertyTree> nullTermTree = createPTreeFromJSONString(json.str());
+        Owned<IPropertyTree> sizedTree = createPTreeFromJSONString(json.length(), json.str());
+        for (IPropertyTree * tree : { nullTermTree.get(), sizedTree.get() })
+        {
+            Owned<IPropertyTreeIterator> values = tree->getElements("v");
+            unsigned i = 0;
+            ForEach(*values)
+            {
+                CPPUNIT_ASSERT(i < expected.size());
+                CPPUNIT_ASSERT_EQUAL(expected[i], std::string(values->query().queryProp(nullptr)));
+                i++;
+            }
+            CPPUNIT_ASSERT_EQUAL(expected.size(), (size_t)i);
+        }
+    }
+
     void testArrayMarkup()
     {
             static constexpr const char * yamlFlowMarkup = R"!!({a: {
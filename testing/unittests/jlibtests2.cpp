@@ -1944,4 +1944,96 @@ CPPUNIT_TEST_SUITE_REGISTRATION(IOURingTest);
 CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(IOURingTest, "IOURingTest");
 
 
+//--------------------------------------------------------------------------------------------------
+
+#include "jcomp.hpp"
+
+class CompileCacheTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(CompileCacheTest);
+        CPPUNIT_TEST(testObjectCache);
+    CPPUNIT_TEST_SUITE_END();
+
+    StringBuffer workDir;
+    StringBuffer cacheDir;
+
+    bool compile(const char * source, const char * option, unsigned & numCached)
+    {
+        VStringBuffer sourceName("%s" PATHSEPSTR "cachetest.cpp", workDir.str());
+        atomicWriteFile(sourceName, source);
+
+        // A new compiler is needed for each compile since compile() adds options to the compiler
+        Owned<ICppCompiler> compiler = createCompiler("cachetest", workDir, workDir, DEFAULT_COMPILER, false, nullptr);
+        VStringBuffer logName("%s" PATHSEPSTR "cachetest.log", workDir.str());
+        compiler->setCCLogPath(logName);
+        compiler->setOnlyCompile(true);
+        compiler->setObjectCacheDir(cacheDir);
+        if (option)
+            compiler->addCompileOption(option);
+        compiler->addSourceFile("cachetest.cpp", nullptr);
+        bool ok = compiler->compile();
+        numCached = compiler->queryNumCachedObjects();
+        return ok;
+    }
+
+public:
+    void testObjectCache()
+    {
+        try
+        {
+            setCompilerPath(nullptr, nullptr, nullptr, nullptr, false);
+        }
+        catch (IException * e)
+        {
+            // No compiler is installed - nothing to test
+            e->Release();
+            return;
+        }
+
+        char cwd[1024];
+        CPPUNIT_ASSERT(GetCurrentDirectory(1024, cwd));
+        workDir.append(cwd).append(PATHSEPCHAR).append("unittest-compilecache");
+        cacheDir.append(workDir).append(PATHSEPCHAR).append("cache");
+        recursiveRemoveDirectory(workDir);
+        CPPUNIT_ASSERT(recursiveCreateDirectory(workDir));
+
+        try
+        {
+            const char * source = "int cachetest(int x) { return x * 2; }\n";
+            const char * changedSource = "int cachetest(int x) { return x * 3; }\n";
+            unsigned numCached = 0;
+
+            CPPUNIT_ASSERT(compile(source, nullptr, numCached));
+            CPPUNIT_ASSERT_EQUAL(0U, numCached);
+
+            CPPUNIT_ASSERT(compile(source, nullptr, numCached));
+            CPPUNIT_ASSERT_EQUAL(1U, numCached);
+
+            // Changes to comments and whitespace are removed by the preprocessor, so still hit the cache
+            VStringBuffer commentedSource("// A comment\n%s", source);
+            CPPUNIT_ASSERT(compile(commentedSource, nullptr, numCached));
+            CPPUNIT_ASSERT_EQUAL(1U, numCached);
+
+            CPPUNIT_ASSERT(compile(changedSource, nullptr, numCached));
+            CPPUNIT_ASSERT_EQUAL(0U, numCached);
+
+            CPPUNIT_ASSERT(compile(source, "-DCACHETEST_OPTION", numCached));
+            CPPUNIT_ASSERT_EQUAL(0U, numCached);
+
+            CPPUNIT_ASSERT(compile(source, "-DCACHETEST_OPTION", numCached));
+            CPPUNIT_ASSERT_EQUAL(1U, numCached);
+        }
+        catch (...)
+        {
+            recursiveRemoveDirectory(workDir);
+            throw;
+        }
+        recursiveRemoveDirectory(workDir);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CompileCacheTest);
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION(CompileCacheTest, "CompileCacheTest");
+
+
 #endif // _USE_CPPUNIT
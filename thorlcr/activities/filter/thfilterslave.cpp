@@ -49,54 +49,41 @@ public:
 };
 
 
-class CFilterSlaveActivity : public CFilterSlaveActivityBase, public CThorSteppable
+class CFilterSlaveActivity;
+class CFilterStrandProcessor : public CThorStrandProcessor
 {
-    typedef CFilterSlaveActivityBase PARENT;
-
+    CFilterSlaveActivity &activity;
     IHThorFilterArg *helper;
-    unsigned matched;
+    bool eof = false;
 
 public:
-    CFilterSlaveActivity(CGraphElementBase *container)
-        : CFilterSlaveActivityBase(container), CThorSteppable(this)
-    {
-        helper = static_cast <IHThorFilterArg *> (queryHelper());
-    }
+    explicit CFilterStrandProcessor(CFilterSlaveActivity &_activity, IEngineRowStream *inputStream, unsigned outputId);
     virtual void start() override
-    {   
-        ActivityTimer s(slaveTimerStats, timeActivities);
-        matched = 0;
-        if (helper->canMatchAny())
-            PARENT::start();
-        else
-        {
-            dataLinkStart();
-            abortSoon = true;
-            stopInput(0);
-        }
+    {
+        CThorStrandProcessor::start();
+        eof = !helper->canMatchAny();
     }
-    CATCH_NEXTROW()
+    STRAND_CATCH_NEXTROW()
     {
         ActivityTimer t(slaveTimerStats, timeActivities);
-        while (!abortSoon)
+        while (!eof)
         {
+            if (parent.queryAbortSoon())
+                return nullptr;
             OwnedConstThorRow row = inputStream->nextRow();
             if (!row)
             {
-                if(anyThisGroup)
+                if (numProcessedLastGroup == rowsProcessed)
+                    row.setown(inputStream->nextRow());
+                if (!row)
                 {
-                    anyThisGroup = false;
-                    break;
+                    numProcessedLastGroup = rowsProcessed;
+                    return nullptr;
                 }
-                row.setown(inputStream->nextRow());
-                if (!row)
-                    break;
             }
             if (helper->isValid(row))
             {
-                matched++;
-                anyThisGroup = true;
-                dataLinkIncrement();
+                rowsProcessed++;
                 return row.getClear();
             }
         }
@@ -107,48 +94,36 @@ public:
         try { return nextRowGENoCatch(seek, numFields, wasCompleteMatch, stepExtra); }
         CATCH_NEXTROWX_CATCH;
     }
-    const void *nextRowGENoCatch(const void *seek, unsigned numFields, bool &wasCompleteMatch, const SmartStepExtra &stepExtra)
+    const void *nextRowGENoCatch(const void *seek, unsigned numFields, bool &wasCompleteMatch, const SmartStepExtra &stepExtra);
+    virtual void resetEOF() override
     {
-        ActivityTimer t(slaveTimerStats, timeActivities);
-        while (!abortSoon)
-        {
-            OwnedConstThorRow ret = inputStream->nextRowGE(seek, numFields, wasCompleteMatch, stepExtra);
-            if (!ret)
-            {
-                abortSoon = true;
-                return NULL;
-            }
-            if (!wasCompleteMatch)
-            {
-                anyThisGroup = false; // RKC->GH - is this right??
-                return ret.getClear();
-            }
-            if (helper->isValid(ret))
-            {
-                anyThisGroup = true;
-                dataLinkIncrement();
-                return ret.getClear();
-            }
-            if (!stepExtra.returnMismatches())
-                return nextRow();
-            if (stepCompare->docompare(ret, seek, numFields) != 0)
-            {
-                wasCompleteMatch = false;
-                anyThisGroup = false; // WHY?
-                return ret.getClear();
-            }
-        }
-        return NULL;
+        eof = !helper->canMatchAny();
+        numProcessedLastGroup = rowsProcessed;
+        CThorStrandProcessor::resetEOF();
     }
-    virtual bool gatherConjunctions(ISteppedConjunctionCollector &collector) override
-    { 
-        return input->gatherConjunctions(collector); 
+};
+
+// Each row is filtered independently, so the filter is spread across strands when the graph requests them (e.g. with
+// a PARALLEL hint). Smart stepping reads through the strand directly, which is only used when it is the only one.
+class CFilterSlaveActivity : public CThorStrandedActivity, public CThorSteppable
+{
+    typedef CThorStrandedActivity PARENT;
+
+public:
+    explicit CFilterSlaveActivity(CGraphElementBase *_container) : CThorStrandedActivity(_container), CThorSteppable(this)
+    {
+        setRequireInitData(false);
+        appendOutputLinked(this);
     }
-    virtual void resetEOF() override
-    { 
-        abortSoon = !helper->canMatchAny();
-        anyThisGroup = false;
-        inputStream->resetEOF();
+    IRangeCompare *queryStepCompare() const { return stepCompare; }
+    virtual CThorStrandProcessor *createStrandProcessor(IEngineRowStream *instream) override
+    {
+        return new CFilterStrandProcessor(*this, instream, 0);
+    }
+    virtual CThorStrandProcessor *createStrandSourceProcessor(bool inputOrdered) override { throwUnexpected(); }
+    virtual bool gatherConjunctions(ISteppedConjunctionCollector &collector) override
+    {
+        return input->gatherConjunctions(collector);
     }
 // steppable
     virtual void setInputStream(unsigned index, CThorInput &input, bool consumerOrdered) override
@@ -156,14 +131,57 @@ public:
         PARENT::setInputStream(index, input, consumerOrdered);
         CThorSteppable::setInputStream(index, input, consumerOrdered);
     }
-    virtual IInputSteppingMeta *querySteppingMeta() { return CThorSteppable::inputStepping; }
+    virtual IInputSteppingMeta *querySteppingMeta() override { return CThorSteppable::inputStepping; }
+// IThorDataLink
     virtual void getMetaInfo(ThorDataLinkMetaInfo &info) const override
     {
-        PARENT::getMetaInfo(info);
+        initMetaInfo(info);
+        info.canReduceNumRows = true;
         info.fastThrough = true;
+        calcMetaInfoSize(info, queryInput(0));
     }
+    virtual bool isGrouped() const override { return queryInput(0)->isGrouped(); }
 };
 
+CFilterStrandProcessor::CFilterStrandProcessor(CFilterSlaveActivity &_activity, IEngineRowStream *inputStream, unsigned outputId)
+    : CThorStrandProcessor(_activity, inputStream, outputId), activity(_activity)
+{
+    helper = static_cast <IHThorFilterArg *> (queryHelper());
+}
+
+const void *CFilterStrandProcessor::nextRowGENoCatch(const void *seek, unsigned numFields, bool &wasCompleteMatch, const SmartStepExtra &stepExtra)
+{
+    ActivityTimer t(slaveTimerStats, timeActivities);
+    while (!eof)
+    {
+        OwnedConstThorRow ret = inputStream->nextRowGE(seek, numFields, wasCompleteMatch, stepExtra);
+        if (!ret)
+        {
+            eof = true;
+            return nullptr;
+        }
+        if (!wasCompleteMatch)
+        {
+            numProcessedLastGroup = rowsProcessed;
+            return ret.getClear();
+        }
+        if (helper->isValid(ret))
+        {
+            rowsProcessed++;
+            return ret.getClear();
+        }
+        if (!stepExtra.returnMismatches())
+            return nextRow();
+        if (activity.queryStepCompare()->docompare(ret, seek, numFields) != 0)
+        {
+            wasCompleteMatch = false;
+            numProcessedLastGroup = rowsProcessed;
+            return ret.getClear();
+        }
+    }
+    return nullptr;
+}
+
 class CFilterProjectSlaveActivity : public CFilterSlaveActivityBase
 {
     typedef CFilterSlaveActivityBase PARENT;
@@ -225,6 +225,7 @@ public:
             options.setCompression(indexCompressionType);
             options.enforceOrder = !isTlk;
             options.isTLK = isTlk;
+            options.parallelSerialize = getOptBool(THOROPT_INDEX_PARALLEL_SERIALIZE, false);
             builder.setown(createKeyBuilder(out, options));
         }
     }
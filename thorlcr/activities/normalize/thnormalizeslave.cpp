@@ -25,65 +25,79 @@
 #include "thexception.hpp"
 
 
-class NormalizeSlaveActivity : public CSlaveActivity
+class CNormalizeStrandProcessor : public CThorStrandProcessor
 {
-    typedef CSlaveActivity PARENT;
-
-    IHThorNormalizeArg * helper;
-    OwnedConstThorRow row;
-    unsigned curRow;
-    unsigned numThisRow;
-    bool anyThisGroup;
+    IHThorNormalizeArg *helper;
     Owned<IEngineRowAllocator> allocator;
-
+    OwnedConstThorRow row;
+    unsigned curRow = 0;
+    unsigned numThisRow = 0;
 
 public:
-    NormalizeSlaveActivity(CGraphElementBase *_container) 
-        : CSlaveActivity(_container)
+    explicit CNormalizeStrandProcessor(CThorStrandedActivity &parent, IEngineRowStream *inputStream, unsigned outputId)
+        : CThorStrandProcessor(parent, inputStream, outputId)
     {
         helper = static_cast <IHThorNormalizeArg *> (queryHelper());
-        allocator.set(queryRowAllocator());
-        setRequireInitData(false);
-        appendOutputLinked(this);
+        Owned<IRowInterfaces> rowIf = parent.getRowInterfaces();
+        allocator.setown(parent.getRowAllocator(rowIf->queryRowMetaData(), (parent.queryHeapFlags()|roxiemem::RHFpacked|roxiemem::RHFunique)));
     }
     virtual void start() override
-    { 
-        ActivityTimer s(slaveTimerStats, timeActivities);
-        PARENT::start();
-        numThisRow = 0;
+    {
+        CThorStrandProcessor::start();
+        row.clear();
         curRow = 0;
-        anyThisGroup = false;
+        numThisRow = 0;
     }
-    CATCH_NEXTROW()
+    STRAND_CATCH_NEXTROW()
     {
         ActivityTimer t(slaveTimerStats, timeActivities);
         for (;;)
         {
             while (curRow == numThisRow)
             {
-                if (abortSoon) 
-                    return NULL;
+                if (parent.queryAbortSoon())
+                    return nullptr;
                 row.setown(inputStream->nextRow());
-                if (!row&&!anyThisGroup)
+                if (!row && (numProcessedLastGroup == rowsProcessed))
                     row.setown(inputStream->nextRow());
-                if(!row) {
-                    anyThisGroup = false;
-                    return NULL;
+                if (!row)
+                {
+                    numProcessedLastGroup = rowsProcessed;
+                    return nullptr;
                 }
                 curRow = 0;
                 numThisRow = helper->numExpandedRows(row);
             }
-            if (abortSoon) 
-                return NULL;
+            if (parent.queryAbortSoon())
+                return nullptr;
             RtlDynamicRowBuilder ret(allocator);
             size32_t sz = helper->transform(ret, row, ++curRow);
-            if (sz!=0) {
-                anyThisGroup = true;
-                dataLinkIncrement();
+            if (sz!=0)
+            {
+                rowsProcessed++;
                 return ret.finalizeRowClear(sz);
             }
         }
     }
+};
+
+// Each input row is expanded independently, so the expansion is spread across strands when the
+// graph requests them (e.g. with a PARALLEL hint).
+class NormalizeSlaveActivity : public CThorStrandedActivity
+{
+public:
+    explicit NormalizeSlaveActivity(CGraphElementBase *_container) : CThorStrandedActivity(_container)
+    {
+        setRequireInitData(false);
+        appendOutputLinked(this);
+    }
+    virtual CThorStrandProcessor *createStrandProcessor(IEngineRowStream *instream) override
+    {
+        return new CNormalizeStrandProcessor(*this, instream, 0);
+    }
+    virtual CThorStrandProcessor *createStrandSourceProcessor(bool inputOrdered) override { throwUnexpected(); }
+
+// IThorDataLink
     virtual bool isGrouped() const override { return queryInput(0)->isGrouped(); }
     virtual void getMetaInfo(ThorDataLinkMetaInfo &info) const override
     {
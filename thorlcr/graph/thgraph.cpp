@@ -2510,7 +2510,7 @@ public:
 
     CGraphExecutor(CJobChannel &_jobChannel) : jobChannel(_jobChannel), job(_jobChannel.queryJob())
     {
-        limit = (unsigned)job.getWorkUnitValueInt("concurrentSubGraphs", globals->getPropInt("@concurrentSubGraphs", 1));
+        limit = job.queryConcurrentSubGraphs();
         DBGLOG("CGraphExecutor: limit = %d", limit);
         waitOnRunning = 0;
         stopped = false;
@@ -2594,19 +2594,30 @@ public:
         job.markWuDirty();
         DBGLOG("CGraphExecutor running=%d, waitingToRun=%d, dependentsWaiting=%d", running.ordinality(), toRun.ordinality(), stack.ordinality());
 
-        while (toRun.ordinality())
+        // The first graph that is ready runs on this thread, any others are launched on new threads if there is capacity.
+        // Graphs that cannot start yet stay in toRun until the next graph completes.
+        Owned<CGraphExecutorGraphInfo> nextGraphInfo;
+        while (toRun.ordinality() && (running.ordinality() < limit))
         {
             if (job.queryPausing())
-                return NULL;
-            Linked<CGraphExecutorGraphInfo> nextGraphInfo = &toRun.item(0);
+                break;
+            if (running.ordinality() && !job.canStartConcurrentSubGraph())
+                break;
+            Linked<CGraphExecutorGraphInfo> graphInfo = &toRun.item(0);
             toRun.remove(0);
-            if (!nextGraphInfo->subGraph->isComplete() && (NULL == findRunning(nextGraphInfo->subGraph->queryGraphId())))
+            if (!graphInfo->subGraph->isComplete() && (NULL == findRunning(graphInfo->subGraph->queryGraphId())))
             {
-                running.append(*nextGraphInfo.getLink());
-                return nextGraphInfo.getClear();
+                running.append(*graphInfo.getLink());
+                if (!nextGraphInfo)
+                    nextGraphInfo.setown(graphInfo.getClear());
+                else
+                {
+                    DBGLOG("graphDone: Launching graph thread for graphId=%" GIDPF "d", graphInfo->subGraph->queryGraphId());
+                    graphPool->start(graphInfo.getClear());
+                }
             }
         }
-        return NULL;
+        return nextGraphInfo.getClear();
     }
 // IGraphExecutor
     virtual void add(CGraphBase *subGraph, IGraphCallback &callback, bool checkDependencies, size32_t parentExtractSz, const byte *parentExtract)
@@ -2663,7 +2674,7 @@ public:
         CriticalBlock b(crit);
         if (0 == subGraph->dependentSubGraphs.ordinality())
         {
-            if (running.ordinality()<limit)
+            if ((running.ordinality()<limit) && ((0 == running.ordinality()) || job.canStartConcurrentSubGraph()))
             {
                 running.append(*LINK(graphInfo));
                 DBGLOG("Add: Launching graph thread for graphId=%" GIDPF "d", subGraph->queryGraphId());
@@ -2715,7 +2726,7 @@ CJobBase::CJobBase(ILoadedDllEntry *_querySo, const char *_graphName) : querySo(
         throwUnexpected();
 }
 
-void CJobBase::applyMemorySettings(const char *context)
+unsigned CJobBase::getQueryMemoryMB(const char *context)
 {
     // NB: 'total' memory has been calculated in advance from either resource settings or from system memory.
     VStringBuffer memoryContext("%sMemory", context);
@@ -2725,13 +2736,21 @@ void CJobBase::applyMemorySettings(const char *context)
     auto getWorkUnitValueFunc = [this](const char *prop, StringBuffer &result) { getWorkUnitValue(prop, result); return result.length()>0;};
     std::unordered_map<std::string, __uint64> memorySpecifications;
     getMemorySpecifications(memorySpecifications, globals, memoryContext, totalMemoryMB, getWorkUnitValueFunc);
-    queryMemoryMB = (unsigned)(memorySpecifications["query"] / 0x100000);
-    if (0 == queryMemoryMB)
+    unsigned memoryMB = (unsigned)(memorySpecifications["query"] / 0x100000);
+    if (0 == memoryMB)
     {
         unsigned totalRequirementsMB = (unsigned)(memorySpecifications["total"] / 0x100000);
         unsigned recommendedMaxMB = (unsigned)(memorySpecifications["recommendedMaxMemory"] / 0x100000);
-        queryMemoryMB = recommendedMaxMB - totalRequirementsMB;
+        memoryMB = recommendedMaxMB - totalRequirementsMB;
     }
+    return memoryMB;
+}
+
+void CJobBase::applyMemorySettings(const char *context)
+{
+    VStringBuffer memoryContext("%sMemory", context);
+    unsigned totalMemoryMB = globals->getPropInt(VStringBuffer("%s/@total", memoryContext.str()));
+    queryMemoryMB = getQueryMemoryMB(context);
 
     // a simple helper used below, to fetch bool from workunit, or the memory settings (either managerMemory or workerMemory) or legacy location
     auto getBoolSetting = [&](const char *setting, bool defaultValue)
@@ -2784,9 +2803,17 @@ void CJobBase::init()
 
     // global setting default on, can be overridden by #option
     timeActivities = getLegacyExpertSettingBool(THOROPT_TIME_ACTIVITIES, true);
+    concurrentSubGraphs = (unsigned)getWorkUnitValueInt(THOROPT_CONCURRENT_SUBGRAPHS, globals->getPropInt("@" THOROPT_CONCURRENT_SUBGRAPHS, 1));
+    if (0 == concurrentSubGraphs)
+        concurrentSubGraphs = 1;
     maxActivityCores = getOptUInt(THOROPT_MAX_ACTIVITY_CORES, 0); // NB: 0 means system decides
     if (0 == maxActivityCores)
-        maxActivityCores = getAffinityCpus();
+    {
+        // share the cores fairly between the subgraphs that may be running at the same time
+        maxActivityCores = getAffinityCpus() / concurrentSubGraphs;
+        if (0 == maxActivityCores)
+            maxActivityCores = 1;
+    }
     pausing = false;
     resumed = false;
 
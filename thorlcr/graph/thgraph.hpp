@@ -889,6 +889,7 @@ protected:
     unsigned channelsPerSlave;
     unsigned numChannels;
     unsigned maxActivityCores, queryMemoryMB, sharedMemoryMB;
+    unsigned concurrentSubGraphs = 1;
     unsigned forceLogGraphIdMin, forceLogGraphIdMax;
     Owned<IContextLogger> logctx;
     Owned<IPerfMonHook> perfmonhook;
@@ -957,7 +958,9 @@ public:
     virtual IGraphTempHandler *createTempHandler(bool errorOnMissing) = 0;
     void addDependencies(IPropertyTree *xgmml, bool failIfMissing=true);
     void addSubGraph(IPropertyTree &xgmml);
+    unsigned getQueryMemoryMB(const char *context);
     void applyMemorySettings(const char *context);
+    virtual bool canStartConcurrentSubGraph() const { return true; }    // Is there capacity to start another subgraph while others are running?
 
     void checkAndReportLeaks(roxiemem::IRowManager *rowManager);
     bool queryUseCheckpoints() const;
@@ -981,6 +984,7 @@ public:
     IGroup &queryJobGroup() const { return *jobGroup; }
     inline bool queryTimeActivities() const { return timeActivities; }
     unsigned queryMaxDefaultActivityCores() const { return maxActivityCores; }
+    unsigned queryConcurrentSubGraphs() const { return concurrentSubGraphs; }
     IGroup &querySlaveGroup() const { return *slaveGroup; }
     virtual mptag_t deserializeMPTag(MemoryBuffer &mb) { throwUnexpected(); }
     virtual mptag_t allocateMPTag() { throwUnexpected(); }
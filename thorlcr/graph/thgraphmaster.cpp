@@ -1537,6 +1537,16 @@ CJobMaster::CJobMaster(IConstWorkUnit &_workunit, const char *graphName, ILoaded
 
     applyMemorySettings("manager");
     sharedAllocator.setown(::createThorAllocator(queryMemoryMB, 0, 1, memorySpillAtPercentage, *logctx, crcChecking, usePackedAllocator));
+
+    if (concurrentSubGraphs > 1)
+    {
+        unsigned memoryPercent = getOptUInt(THOROPT_CONCURRENT_SUBGRAPH_MEMORY, 50);
+        if (memoryPercent)
+        {
+            concurrentSubGraphMemoryLimit = ((unsigned __int64)getQueryMemoryMB("worker") * 0x100000) * memoryPercent / 100;
+            PROGLOG("concurrentSubGraphs = %u, no more are started while a worker uses more than %u MB of row memory", concurrentSubGraphs, (unsigned)(concurrentSubGraphMemoryLimit / 0x100000));
+        }
+    }
     Owned<IMPServer> mpServer = getMPServer();
     CJobChannel *channel = addChannel(mpServer);
     channel->reservePortKind(TPORT_mp);
@@ -1593,6 +1603,55 @@ static IException *createBCastException(unsigned slave, const char *errorMsg)
     return e.getClear();
 }
 
+bool CJobMaster::canStartConcurrentSubGraph() const
+{
+    if (0 == concurrentSubGraphMemoryLimit)
+        return true;
+    // The row memory is shared by all the subgraphs running on a worker, so a new subgraph is only started if every
+    // channel has enough headroom left for it.  Only the reports from subgraphs that are still running are used - the
+    // memory used by a completed subgraph has been released.
+    std::vector<stat_type> channelRowMemory(queryClusterWidth());
+    {
+        CriticalBlock b(rowMemoryCrit);
+        for (auto &subGraph : subGraphRowMemory)
+        {
+            for (unsigned node=0; node < channelRowMemory.size(); node++)
+            {
+                if (subGraph.second[node] > channelRowMemory[node])
+                    channelRowMemory[node] = subGraph.second[node];
+            }
+        }
+    }
+    // Each channel reports the row memory of its whole worker process, so every report is checked against the limit.
+    for (unsigned node=0; node < channelRowMemory.size(); node++)
+    {
+        if (channelRowMemory[node] > concurrentSubGraphMemoryLimit)
+        {
+            LOG(MCthorDetailedDebugInfo, "Delaying concurrent subgraph - worker channel %u is using %" I64F "u bytes of row memory", node+1, (unsigned __int64)channelRowMemory[node]);
+            return false;
+        }
+    }
+    return true;
+}
+
+void CJobMaster::noteWorkerRowMemory(graph_id subGraphId, unsigned node, stat_type rowMemory)
+{
+    if (0 == concurrentSubGraphMemoryLimit)
+        return;
+    CriticalBlock b(rowMemoryCrit);
+    std::vector<stat_type> &channelRowMemory = subGraphRowMemory[subGraphId];
+    if (channelRowMemory.empty())
+        channelRowMemory.resize(queryClusterWidth());
+    if (node < channelRowMemory.size())
+        channelRowMemory[node] = rowMemory;
+}
+
+void CJobMaster::clearWorkerRowMemory(graph_id subGraphId)
+{
+    CriticalBlock b(rowMemoryCrit);
+    subGraphRowMemory.erase(subGraphId);
+}
+
 mptag_t CJobMaster::allocateMPTag()
 {
     mptag_t tag = allocateClusterMPTag();
@@ -2133,7 +2192,6 @@ bool CJobMaster::go()
         throw MakeStringException(0, "Job paused at start, exiting");
 
     bool allDone = true;
-    unsigned concurrentSubGraphs = (unsigned)getWorkUnitValueInt("concurrentSubGraphs", globals->getPropInt("@concurrentSubGraphs", 1));
     try
     {
         startJob();
@@ -3090,6 +3148,7 @@ void CMasterGraph::setComplete(bool tf)
     if (tf && !queryOwner())
     {
         job.queryWorkUnit().setNodeState(job.queryGraphName(), graphId, graphDone?WUGraphComplete:WUGraphFailed);
+        jobM->clearWorkerRowMemory(graphId);
     }
 }
 
@@ -3098,6 +3157,11 @@ bool CMasterGraph::deserializeStats(unsigned node, MemoryBuffer &mb)
     CriticalBlock b(createdCrit);
 
     graphStats.deserialize(node, mb);
+    // Child graphs report the memory of the subgraph that they belong to
+    CGraphBase *subGraph = this;
+    while (subGraph->queryOwner())
+        subGraph = subGraph->queryOwner();
+    jobM->noteWorkerRowMemory(subGraph->queryGraphId(), node, graphStats.getStatistic(node, StSizeRowMemory));
     unsigned count;
     mb.read(count);
     if (count)
@@ -66,6 +66,10 @@ public:
             summary.merge(*nodeStats[n], n);
         summary.recordStatistics(result);
     }
+    stat_type getStatistic(unsigned node, StatisticKind kind)
+    {
+        return nodeStats[node]->getStatisticValue(kind);
+    }
     stat_type getStatisticSum(StatisticKind kind)
     {
         stat_type total = 0;
@@ -186,6 +190,9 @@ class graphmaster_decl CJobMaster : public CJobBase
     SocketEndpoint agentEp;
     CriticalSection sendQueryCrit, spillCrit;
     graph_id currentSubGraphId = 0;
+    mutable CriticalSection rowMemoryCrit;
+    std::unordered_map<graph_id, std::vector<stat_type>> subGraphRowMemory; // latest row memory reported by each channel of each running subgraph
+    unsigned __int64 concurrentSubGraphMemoryLimit = 0; // per worker, 0 if concurrent subgraphs are not limited by memory
 
     void initNodeDUCache();
 
@@ -209,6 +216,8 @@ public:
     void captureJobInfo(IConstWorkUnit &wu, JobInfoCaptureType flags);
     void setCurrentSubGraphId(graph_id _subGraphId) { currentSubGraphId = _subGraphId; }
     graph_id queryCurrentSubGraphId() const { return currentSubGraphId; }
+    void noteWorkerRowMemory(graph_id subGraphId, unsigned node, stat_type rowMemory);
+    void clearWorkerRowMemory(graph_id subGraphId);
 
     virtual IConstWorkUnit &queryWorkUnit() const
     {
@@ -226,6 +235,7 @@ public:
         dirty = true;
     }
 // CJobBase impls.
+    virtual bool canStartConcurrentSubGraph() const override;
     virtual mptag_t allocateMPTag();
     virtual void freeMPTag(mptag_t tag);
     virtual IGraphTempHandler *createTempHandler(bool errorOnMissing);
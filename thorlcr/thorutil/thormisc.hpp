@@ -132,6 +132,9 @@
 #define THOROPT_KJ_STRIPE_OUT_OF_CLUSTER_LOOKUPS "keyedJoinStripeOutOfClusterLookups" // Stripe out of cluster keyed lookups (default = false)
 #define THOROPT_NEWLOOKAHEAD "newlookahead"                                       // Use new lookahead implementation (default = true)
 #define THOROPT_FORCE_NEWLOOKAHEAD "forcenewlookahead"                            // Force new lookahead implementation and allow spilling
+#define THOROPT_INDEX_PARALLEL_SERIALIZE "indexParallelSerialize"                 // Serialize completed inplace index nodes in parallel - compression remains serial (default = false)
+#define THOROPT_CONCURRENT_SUBGRAPHS "concurrentSubGraphs"                       // Maximum number of independent subgraphs that can run at the same time (default = 1)
+#define THOROPT_CONCURRENT_SUBGRAPH_MEMORY "concurrentSubGraphMemoryPercent"      // Do not start another concurrent subgraph if any worker uses more than this % of its row memory (default = 50, 0 = no limit)
 
 constexpr bool defaultNewLookAhead = true;
 
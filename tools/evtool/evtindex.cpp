@@ -26,5 +26,6 @@ IEvToolCommand* createIndexCommand()
         { "summarize", createIndexSummaryCommand },
         { "hotspot", createIndexHotspotCommand },
         { "plot", createIndexPlotCommand },
+        { "replay", createIndexReplayCommand },
     }, verbose, brief);
 }
@@ -24,3 +24,4 @@
 extern IEvToolCommand* createIndexSummaryCommand();
 extern IEvToolCommand* createIndexHotspotCommand();
 extern IEvToolCommand* createIndexPlotCommand();
+extern IEvToolCommand* createIndexReplayCommand();
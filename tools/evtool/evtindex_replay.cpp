@@ -0,0 +1,97 @@
+/*##############################################################################
+
+    Copyright (C) 2025 HPCC Systems®.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+############################################################################## */
+
+#include "evtindex.hpp"
+#include "eventindexreplay.h"
+#include "jevent.hpp"
+
+// Connector between the CLI and the index replay operation.
+class CEvtIndexReplayCommand : public TEventConsumingCommand<CIndexReplayOp>
+{
+public:
+    virtual bool acceptKVOption(const char* key, const char* value) override
+    {
+        if (op.setCacheSize(key, value))
+            return true;
+        if (streq(key, "source-prefix"))
+        {
+            op.setSourcePrefix(value);
+            return true;
+        }
+        if (streq(key, "target-prefix"))
+        {
+            op.setTargetPrefix(value);
+            return true;
+        }
+        if (streq(key, "speed"))
+        {
+            op.setSpeed(atof(value));
+            return true;
+        }
+        if (streq(key, "threads"))
+        {
+            op.setThreads(atoi(value));
+            return true;
+        }
+        return TEventConsumingCommand<CIndexReplayOp>::acceptKVOption(key, value);
+    }
+
+    virtual const char* getVerboseDescription() const override
+    {
+        return R"!!!(Replay the index node accesses recorded in a binary event file through the
+production node cache, using local copies of the index files. The cache sizes,
+replay speed and number of replay threads are configurable. The hits, loads,
+evictions and access latencies observed in the real cache are reported in CSV
+format, with one row per node kind.
+)!!!";
+    }
+
+    virtual const char* getBriefDescription() const override
+    {
+        return "replay recorded index accesses through the real node cache";
+    }
+
+    virtual void usageSyntax(StringBuffer& helpText) override
+    {
+        helpText.append(R"!!!([options] [filters] <filename>
+)!!!");
+    }
+
+    virtual void usageOptions(IBufferedSerialOutputStream& out) override
+    {
+        TEventConsumingCommand<CIndexReplayOp>::usageOptions(out);
+        constexpr const char* usageStr =
+R"!!!(    --node-cache=<size>       Size of the branch node cache, e.g. 100MB.
+    --leaf-cache=<size>       Size of the leaf node cache.
+    --blob-cache=<size>       Size of the blob node cache.
+    --source-prefix=<path>    Prefix of the recorded index file paths that is
+                              replaced by --target-prefix.
+    --target-prefix=<path>    Location of the local copies of the index files.
+    --speed=<factor>          Replay relative to the recorded timestamps, e.g.
+                              2 replays twice as fast as recorded. The default,
+                              0, replays as fast as possible.
+    --threads=<n>             Number of threads replaying accesses. Default 1.
+)!!!";
+        size32_t usageStrLength = size32_t(strlen(usageStr));
+        out.put(usageStrLength, usageStr);
+    }
+};
+
+IEvToolCommand* createIndexReplayCommand()
+{
+    return new CEvtIndexReplayCommand();
+}
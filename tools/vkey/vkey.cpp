@@ -69,9 +69,9 @@ inline void SwapBigEndian(KeyHdr &hdr)
     _WINREV(hdr.hghtrn);
     _WINREV(hdr.hdrseq);
     _WINREV(hdr.tstamp);
+    _WINREV(hdr.dictionaryHead);
     _WINREV(hdr.rs3[0]);
     _WINREV(hdr.rs3[1]);
-    _WINREV(hdr.rs3[2]);
     _WINREV(hdr.fposOffset);
     _WINREV(hdr.fileSize);
     _WINREV(hdr.nodeKeyLength);